@@ -0,0 +1,363 @@
+#ifndef _OPENMP
+#define _OPENMP
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <tuple>
+#include <random>
+#include <algorithm>
+#include <omp.h>
+#include <gve.hxx>
+
+using namespace std;
+
+
+
+
+#pragma region TYPES
+/** Vertex id type. */
+using K = uint32_t;
+/** Edge weight type. */
+using E = float;
+/** Graph type used for loading and updates. */
+using Graph = gve::ArenaDiGraph<K, GVE_NONE, E>;
+
+
+/**
+ * Options for the benchmark.
+ */
+struct BenchOptions {
+  /** Command to run (generate, run). */
+  string command;
+  /** Input MTX file (run), or output MTX file (generate). */
+  string file;
+  /** Output file for results [stdout]. */
+  string output;
+  /** Output format (csv, json) [csv]. */
+  string format = "csv";
+  /** Thread counts to run with [1, 2, 4, ..., max]. */
+  vector<int> threads;
+  /** Batch sizes, as fractions of the number of edges [10^-7, ..., 10^-1]. */
+  vector<double> batchFractions = {1e-7, 1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1};
+  /** Number of times to repeat each measurement [1]. */
+  int repeat = 1;
+  /** Random seed [42]. */
+  size_t seed = 42;
+  /** log2 of number of vertices, for generated graph [20]. */
+  int scale = 20;
+  /** Average degree, for generated graph [16]. */
+  int edgeFactor = 16;
+  /** Generate an undirected graph? */
+  bool undirected = false;
+};
+
+
+/**
+ * Timing of a benchmark phase.
+ */
+struct BenchRecord {
+  /** Number of threads used. */
+  int threads;
+  /** Batch size, as fraction of the number of edges (0 if not a batch phase). */
+  double batchFraction;
+  /** Number of edges in batch (0 if not a batch phase). */
+  size_t batchSize;
+  /** Name of the phase. */
+  string phase;
+  /** Number of vertices in graph. */
+  size_t order;
+  /** Number of edges in graph. */
+  size_t size;
+  /** Average time taken [ms]. */
+  float time;
+};
+#pragma endregion
+
+
+
+
+#pragma region OPTIONS
+/**
+ * Split a comma-separated list of values.
+ * @param s comma-separated list
+ * @param fp parse function (value string)
+ * @returns parsed values
+ */
+template <class T, class FP>
+inline vector<T> splitList(const string& s, FP fp) {
+  vector<T> a;
+  size_t i = 0;
+  while (i <= s.size()) {
+    size_t j = s.find(',', i);
+    if (j == string::npos) j = s.size();
+    if (j > i) a.push_back(fp(s.substr(i, j-i)));
+    i = j + 1;
+  }
+  return a;
+}
+
+
+/**
+ * Show usage of the benchmark.
+ */
+inline void printUsage() {
+  fprintf(stderr,
+    "Usage:\n"
+    "  gve_bench generate <output.mtx> [-s scale] [-e edge-factor] [--seed N] [--undirected]\n"
+    "  gve_bench run <input.mtx> [-t threads,...] [-b batch-fractions,...] [-r repeat]\n"
+    "                             [-f csv|json] [-o output] [--seed N]\n");
+}
+
+
+/**
+ * Parse command-line options.
+ * @param argc number of arguments
+ * @param argv arguments
+ * @returns benchmark options
+ */
+inline BenchOptions parseOptions(int argc, char **argv) {
+  BenchOptions o;
+  if (argc < 3) return o;
+  o.command = argv[1];
+  o.file    = argv[2];
+  auto fint = [](const string& s) { return stoi(s); };
+  auto fdbl = [](const string& s) { return stod(s); };
+  for (int i=3; i<argc; ++i) {
+    string k = argv[i];
+    bool   v = i+1 < argc;
+    if      (k=="--undirected")               o.undirected = true;
+    else if ((k=="-t" || k=="--threads") && v) o.threads = splitList<int>(argv[++i], fint);
+    else if ((k=="-b" || k=="--batch")   && v) o.batchFractions = splitList<double>(argv[++i], fdbl);
+    else if ((k=="-r" || k=="--repeat")  && v) o.repeat = stoi(argv[++i]);
+    else if ((k=="-f" || k=="--format")  && v) o.format = argv[++i];
+    else if ((k=="-o" || k=="--output")  && v) o.output = argv[++i];
+    else if ((k=="-s" || k=="--scale")   && v) o.scale  = stoi(argv[++i]);
+    else if ((k=="-e" || k=="--edge-factor") && v) o.edgeFactor = stoi(argv[++i]);
+    else if (k=="--seed" && v) o.seed = stoull(argv[++i]);
+    else { fprintf(stderr, "Unknown option: %s\n", k.c_str()); o.command.clear(); }
+  }
+  if (o.threads.empty()) {
+    for (int t=1; t<omp_get_max_threads(); t*=2)
+      o.threads.push_back(t);
+    o.threads.push_back(omp_get_max_threads());
+  }
+  return o;
+}
+#pragma endregion
+
+
+
+
+#pragma region GENERATE
+/**
+ * Generate an R-MAT graph, and write it to an MTX file.
+ * @param o benchmark options
+ * @returns zero on success
+ */
+inline int runGenerate(const BenchOptions& o) {
+  size_t N = size_t(1) << o.scale;
+  size_t M = size_t(o.edgeFactor) << o.scale;
+  fprintf(stderr, "Generating R-MAT graph [scale=%d, edges=%zu] ...\n", o.scale, M);
+  auto edges = gve::generateRmatEdgesOmp<K>(o.seed, o.scale, M, GVE_NONE());
+  // Keep a single copy of each edge (lower triangular if undirected).
+  if (o.undirected) {
+    #pragma omp parallel for schedule(static, 2048)
+    for (size_t i=0; i<edges.size(); ++i) {
+      auto [u, v, w] = edges[i];
+      if (u < v) edges[i] = {v, u, w};
+    }
+  }
+  gve::sortEdgesByIdOmpU(edges);
+  gve::uniqueEdgesU(edges);
+  FILE *f = fopen(o.file.c_str(), "w");
+  if (!f) { fprintf(stderr, "Cannot open %s\n", o.file.c_str()); return 1; }
+  fprintf(f, "%%%%MatrixMarket matrix coordinate pattern %s\n", o.undirected? "symmetric" : "general");
+  fprintf(f, "%zu %zu %zu\n", N, N, edges.size());
+  for (auto [u, v, w] : edges)
+    fprintf(f, "%u %u\n", unsigned(u+1), unsigned(v+1));
+  fclose(f);
+  fprintf(stderr, "Wrote %zu unique edges to %s\n", edges.size(), o.file.c_str());
+  return 0;
+}
+#pragma endregion
+
+
+
+
+#pragma region RUN
+/**
+ * Convert a batch update to the format used by dynamic algorithms.
+ * @param edges edges in batch update {u, v, w}
+ * @returns edges {u, v}
+ */
+template <class V>
+inline vector<tuple<K, K>> batchKeys(const vector<tuple<K, K, V>>& edges) {
+  vector<tuple<K, K>> a;
+  a.reserve(edges.size());
+  for (auto [u, v, w] : edges)
+    a.push_back({u, v});
+  return a;
+}
+
+
+/**
+ * Time each graph operation on an MTX file, across thread counts and batch sizes.
+ * @param a timing records (output)
+ * @param o benchmark options
+ */
+inline void runBenchmarks(vector<BenchRecord>& a, const BenchOptions& o) {
+  gve::MappedFile mf(o.file.c_str());
+  string_view data((const char*) mf.data(), mf.size());
+  string_view head = data.substr(0, data.find('\n'));
+  bool weighted  = head.find("pattern") == string_view::npos;
+  bool symmetric = head.find("symmetric") != string_view::npos;
+  auto fload = [&](Graph& x) {
+    if (weighted) gve::readMtxFormatToGraphOmpW<true>(x, data);
+    else          gve::readMtxFormatToGraphOmpW<false>(x, data);
+  };
+  int R = o.repeat;
+  gve::PagerankOptions<double> po;
+  for (int T : o.threads) {
+    omp_set_num_threads(T);
+    Graph x, y;
+    auto frecord = [&](double f, size_t b, const char *phase, const auto& g, float t) {
+      a.push_back({T, f, b, phase, g.order(), g.size(), t});
+      fprintf(stderr, "{%09.1fms, threads=%d, batch=%zu} %s\n", t, T, b, phase);
+    };
+    // Load and clone the graph.
+    float t = gve::measureDurationMarked([&](auto mark) {
+      x.clearOmp();
+      mark([&]() { fload(x); });
+    }, R);
+    frecord(0, 0, "load", x, t);
+    t = gve::measureDurationMarked([&](auto mark) {
+      mark([&]() { gve::duplicateArenaOmpW(y, x); });
+    }, R);
+    frecord(0, 0, "clone", y, t);
+    // Transpose the graph.
+    t = gve::measureDurationMarked([&](auto mark) {
+      gve::DiGraph<K, GVE_NONE, E> xt;
+      mark([&]() { gve::transposeOmpW(xt, x); });
+    }, R);
+    frecord(0, 0, "transpose", x, t);
+    gve::DiGraphCsr<K, K, E> xt;
+    t = gve::measureDurationMarked([&](auto mark) {
+      mark([&]() { gve::transposeWithDegreeCsrOmpW(xt, x); });
+    }, R);
+    frecord(0, 0, "transposeCsr", x, t);
+    // Run static algorithms.
+    gve::PagerankResult<double> r0;
+    t = gve::measureDurationMarked([&](auto mark) {
+      mark([&]() { r0 = gve::pagerankStaticOmp(xt, po); });
+    }, R);
+    frecord(0, 0, "pagerankStatic", x, t);
+    t = gve::measureDurationMarked([&](auto mark) {
+      mark([&]() { gve::leidenStaticOmp(x); });
+    }, R);
+    frecord(0, 0, "leidenStatic", x, t);
+    // Apply batch updates of each size.
+    for (double f : o.batchFractions) {
+      size_t B = max(size_t(1), size_t(ceil(f * x.size())));
+      vector<tuple<K, K, E>> deletions, insertions;
+      default_random_engine rnd(o.seed);
+      t = gve::measureDurationMarked([&](auto mark) {
+        mark([&]() {
+          deletions  = gve::generateEdgeDeletions (rnd, x, B, 0, x.span(), symmetric);
+          insertions = gve::generateEdgeInsertions(rnd, x, B, 0, x.span(), symmetric, E(1));
+          gve::tidyBatchUpdateU(deletions, insertions, x);
+        });
+      }, R);
+      frecord(f, B, "generateBatch", x, t);
+      vector<tuple<K, K, E>> none;
+      t = gve::measureDurationMarked([&](auto mark) {
+        gve::duplicateArenaOmpW(y, x);
+        mark([&]() { gve::applyBatchUpdateOmpU(y, deletions, none); });
+      }, R);
+      frecord(f, B, "deleteBatch", y, t);
+      t = gve::measureDurationMarked([&](auto mark) {
+        gve::duplicateArenaOmpW(y, x);
+        mark([&]() { gve::applyBatchUpdateOmpU(y, none, insertions); });
+      }, R);
+      frecord(f, B, "insertBatch", y, t);
+      t = gve::measureDurationMarked([&](auto mark) {
+        gve::duplicateArenaOmpW(y, x);
+        mark([&]() { gve::applyBatchUpdateOmpU(y, deletions, insertions); });
+      }, R);
+      frecord(f, B, "updateBatch", y, t);
+      // Update the transpose in CSR, keeping slack for insertions.
+      gve::DiGraphCsr<K, K, E> zt;
+      t = gve::measureDurationMarked([&](auto mark) {
+        gve::transposeWithDegreeCsrOmpW(zt, x, 0.1);
+        mark([&]() { gve::transposeWithDegreeCsrBatchUpdateOmpU(zt, y, deletions, insertions, 0.1); });
+      }, R);
+      frecord(f, B, "transposeCsrBatch", y, t);
+      // Run PageRank on the updated graph.
+      auto yt = gve::transposeWithDegreeCsrOmp(y);
+      auto dk = batchKeys(deletions);
+      auto ik = batchKeys(insertions);
+      t = gve::measureDurationMarked([&](auto mark) {
+        mark([&]() { gve::pagerankStaticOmp(yt, po); });
+      }, R);
+      frecord(f, B, "pagerankStatic", y, t);
+      t = gve::measureDurationMarked([&](auto mark) {
+        mark([&]() { gve::pagerankDynamicFrontierOmp(x, xt, y, yt, dk, ik, &r0.ranks, po); });
+      }, R);
+      frecord(f, B, "pagerankDynamicFrontier", y, t);
+    }
+  }
+}
+#pragma endregion
+
+
+
+
+#pragma region OUTPUT
+/**
+ * Write timing records in CSV format.
+ * @param f output file
+ * @param a timing records
+ */
+inline void writeRecordsCsv(FILE *f, const vector<BenchRecord>& a) {
+  fprintf(f, "threads,batch_fraction,batch_size,phase,order,size,time_ms\n");
+  for (const auto& r : a)
+    fprintf(f, "%d,%g,%zu,%s,%zu,%zu,%.3f\n", r.threads, r.batchFraction, r.batchSize, r.phase.c_str(), r.order, r.size, r.time);
+}
+
+
+/**
+ * Write timing records in JSON format.
+ * @param f output file
+ * @param a timing records
+ */
+inline void writeRecordsJson(FILE *f, const vector<BenchRecord>& a) {
+  fprintf(f, "[\n");
+  for (size_t i=0; i<a.size(); ++i) {
+    const auto& r = a[i];
+    fprintf(f, "  {\"threads\": %d, \"batch_fraction\": %g, \"batch_size\": %zu, \"phase\": \"%s\", \"order\": %zu, \"size\": %zu, \"time_ms\": %.3f}%s\n",
+      r.threads, r.batchFraction, r.batchSize, r.phase.c_str(), r.order, r.size, r.time, i+1<a.size()? "," : "");
+  }
+  fprintf(f, "]\n");
+}
+#pragma endregion
+
+
+
+
+int main(int argc, char **argv) {
+  BenchOptions o = parseOptions(argc, argv);
+  if (o.command == "generate") return runGenerate(o);
+  if (o.command != "run" || (o.format!="csv" && o.format!="json")) { printUsage(); return 1; }
+  vector<BenchRecord> records;
+  runBenchmarks(records, o);
+  FILE *f = o.output.empty()? stdout : fopen(o.output.c_str(), "w");
+  if (!f) { fprintf(stderr, "Cannot open %s\n", o.output.c_str()); return 1; }
+  if (o.format == "json") writeRecordsJson(f, records);
+  else writeRecordsCsv(f, records);
+  if (f != stdout) fclose(f);
+  return 0;
+}
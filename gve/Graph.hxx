@@ -3,13 +3,16 @@
 // See LICENSE for full terms
 #pragma once
 
+#include <cstdint>
 #include <cstring>
 #include <utility>
+#include <type_traits>
 #include <iterator>
 #include <memory>
 #include <vector>
 #include <ostream>
 #include <algorithm>
+#include <stdexcept>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -89,6 +92,14 @@ class ArenaDiGraph {
   size_t M = 0;
   /** Memory reserved for vertices. */
   size_t RESV = 0;
+  /** Are the edges of each vertex shared with a snapshot (copy-on-write)? */
+  char *frozen = nullptr;
+  /** Edge blocks retired while shared with a snapshot {pointer, bytes}, per thread. */
+  vector<vector<pair<void*, size_t>>> retired;
+  /** Edge blocks retired by threads beyond those in `retired` {pointer, bytes}. */
+  vector<pair<void*, size_t>> retiredRest;
+  /** Is this a read-only view, sharing the edges of another graph? */
+  bool view = false;
   #pragma endregion
 
 
@@ -232,6 +243,7 @@ class ArenaDiGraph {
    * Get an iterator to the begin of edges of a vertex.
    * @param u vertex id
    * @returns begin iterator of edges
+   * @note Edges shared with a snapshot must not be written through this; use `beginMutableEdges()`.
    */
   inline pair<K, E>* beginEdges(K u) noexcept {
     return u < span()? edges[u] : nullptr;
@@ -242,10 +254,37 @@ class ArenaDiGraph {
    * Get an iterator to the end of edges of a vertex.
    * @param u vertex id
    * @returns end iterator of edges
+   * @note Edges shared with a snapshot must not be written through this; use `endMutableEdges()`.
    */
   inline pair<K, E>* endEdges(K u) noexcept {
     return u < span()? edges[u] + degrees[u] : nullptr;
   }
+
+
+  /**
+   * Get an iterator to the begin of edges of a vertex, for writing.
+   * @param u vertex id
+   * @returns begin iterator of edges
+   * @note Edges shared with a snapshot are copied first (copy-on-write).
+   */
+  inline pair<K, E>* beginMutableEdges(K u) {
+    if (u >= span()) return nullptr;
+    thawEdges(u);
+    return edges[u];
+  }
+
+
+  /**
+   * Get an iterator to the end of edges of a vertex, for writing.
+   * @param u vertex id
+   * @returns end iterator of edges
+   * @note Edges shared with a snapshot are copied first (copy-on-write).
+   */
+  inline pair<K, E>* endMutableEdges(K u) {
+    if (u >= span()) return nullptr;
+    thawEdges(u);
+    return edges[u] + degrees[u];
+  }
   #pragma endregion
 
 
@@ -350,11 +389,12 @@ class ArenaDiGraph {
    * @param w associated weight of the edge
    * @returns success?
    */
-  inline bool setEdgeValue(K u, K v, E w) noexcept {
+  inline bool setEdgeValue(K u, K v, E w) {
     if (u >= span()) return false;
     auto ib = edges[u], ie = edges[u] + degrees[u];
     auto it = findEntry(ib, ie, v);
     if (it == ie) return false;
+    if (frozen[u]) { thawEdges(u); it = edges[u] + (it - ib); }
     (*it).second = w;
     return true;
   }
@@ -410,6 +450,42 @@ class ArenaDiGraph {
   }
 
 
+  /**
+   * Free the edges of a vertex, or retire them if they are shared with a snapshot.
+   * @param u source vertex id
+   * @note The edge pointer of the vertex is left as is.
+   */
+  inline void releaseEdges(K u) {
+    if (!edges[u]) return;
+    if (!frozen[u]) { deallocate(edges[u], capacities[u]); return; }
+#ifdef _OPENMP
+    size_t t = omp_get_thread_num();
+#else
+    size_t t = 0;
+#endif
+    if (t < retired.size()) retired[t].push_back({edges[u], capacities[u]*EDGE});
+    else {
+      // More threads than at snapshot time.
+      #pragma omp critical (ArenaDiGraphRetired)
+      retiredRest.push_back({edges[u], capacities[u]*EDGE});
+    }
+    frozen[u] = 0;
+  }
+
+
+  /**
+   * Give a vertex its own copy of edges, if they are shared with a snapshot.
+   * @param u source vertex id
+   */
+  inline void thawEdges(K u) {
+    if (!frozen[u]) return;
+    pair<K, E> *ptr = allocate(capacities[u]);
+    std::memcpy(ptr, edges[u], degrees[u] * EDGE);
+    releaseEdges(u);
+    edges[u] = ptr;
+  }
+
+
   /**
    * Resize arrays to specified size.
    * @param n new size
@@ -425,6 +501,7 @@ class ArenaDiGraph {
     degrees    = reallocateValues(degrees, SPAN, RESV, n, resv);
     capacities = reallocateValues(capacities, SPAN, RESV, n, resv);
     values     = reallocateValues(values, SPAN, RESV, n, resv);
+    frozen     = reallocateValues(frozen, SPAN, RESV, n, resv);
     exists     = reallocateValues(exists, ceilDiv(SPAN, B), ceilDiv(RESV, B), ceilDiv(n, B), ceilDiv(resv, B));
     // Update span and reserved size.
     SPAN = n;
@@ -438,6 +515,7 @@ class ArenaDiGraph {
    * @note The edges are not cleared!
    */
   inline void resizeArraysOmp(size_t n) {
+#ifdef _OPENMP
     constexpr size_t B = 8 * sizeof(bool_type);
     // Compute new reserved size (round up to page size).
     size_t resv = ceilDiv(n, size_t(GVE_PAGE_SIZE)) * GVE_PAGE_SIZE;
@@ -447,10 +525,14 @@ class ArenaDiGraph {
     degrees    = reallocateValuesOmp(degrees, SPAN, RESV, n, resv);
     capacities = reallocateValuesOmp(capacities, SPAN, RESV, n, resv);
     values     = reallocateValuesOmp(values, SPAN, RESV, n, resv);
+    frozen     = reallocateValuesOmp(frozen, SPAN, RESV, n, resv);
     exists     = reallocateValuesOmp(exists, ceilDiv(SPAN, B), ceilDiv(RESV, B), ceilDiv(n, B), ceilDiv(resv, B));
     // Update span and reserved size.
     SPAN = n;
     RESV = resv;
+#else
+    resizeArrays(n);
+#endif
   }
 
 
@@ -462,6 +544,11 @@ class ArenaDiGraph {
     if (u >= span()) return;
     auto fl = [](const auto& a, const auto& b) { return a.first < b.first; };
     auto ib = edges[u], ie = edges[u] + degrees[u];
+    if (frozen[u]) {
+      if (std::is_sorted(ib, ie, fl)) return;
+      thawEdges(u);
+      ib = edges[u]; ie = edges[u] + degrees[u];
+    }
     std::sort(ib, ie, fl);
   }
 
@@ -474,6 +561,11 @@ class ArenaDiGraph {
     if (u >= span()) return;
     auto fe = [](const auto& a, const auto& b) { return a.first == b.first; };
     auto ib = edges[u], ie = edges[u] + degrees[u];
+    if (frozen[u]) {
+      if (std::adjacent_find(ib, ie, fe) == ie) return;
+      thawEdges(u);
+      ib = edges[u]; ie = edges[u] + degrees[u];
+    }
     auto it = std::unique(ib, ie, fe);
     degrees[u] = it - ib;
   }
@@ -486,7 +578,7 @@ class ArenaDiGraph {
    */
   inline void clearEdges(K u) {
     if (u >= span() || !edges[u]) return;
-    deallocate(edges[u], capacities[u]);
+    releaseEdges(u);
     edges[u] = nullptr;
     degrees[u] = 0;
     capacities[u] = 0;
@@ -497,10 +589,11 @@ class ArenaDiGraph {
    * Remove all vertices and edges from the graph.
    */
   inline void clear() {
+    if (view) { SPAN = 0; N = 0; M = 0; view = false; return; }
     if (mx == nullptr) return;
     // Clear all edges first, if the allocator is shared.
     bool isShared = mx.use_count() > 1;
-    if (!isShared)  mx->reset();
+    if (!isShared) { mx->reset(); retired.clear(); retiredRest.clear(); }
     else {
       for (K u=0; u<SPAN; ++u)
         clearEdges(u);
@@ -514,10 +607,11 @@ class ArenaDiGraph {
    * Remove all vertices and edges from the graph [parallel].
    */
   inline void clearOmp() {
+    if (view) { SPAN = 0; N = 0; M = 0; view = false; return; }
     if (mx == nullptr) return;
     // Clear all edges first, if the allocator is shared.
     bool isShared = mx.use_count() > 1;
-    if (!isShared)  mx->reset();
+    if (!isShared) { mx->reset(); retired.clear(); retiredRest.clear(); }
     else {
       #pragma omp parallel for schedule(dynamic, 2048)
       for (K u=0; u<SPAN; ++u)
@@ -552,7 +646,7 @@ class ArenaDiGraph {
     if (u >= span()) return;
     // Deallocate if no edges are expected.
     if (deg==0 && degrees[u]==0) {
-      deallocate(edges[u], capacities[u]);
+      releaseEdges(u);
       edges[u] = nullptr;
       capacities[u] = 0;
       return;
@@ -563,7 +657,7 @@ class ArenaDiGraph {
     // Allocate new memory and copy old data.
     pair<K, E> *ptr = allocate(cap);
     std::memcpy(ptr, edges[u], degrees[u] * EDGE);
-    deallocate(edges[u], capacities[u]);
+    releaseEdges(u);
     // Update pointer and capacities.
     edges[u] = ptr;
     capacities[u] = cap;
@@ -747,6 +841,7 @@ class ArenaDiGraph {
    * @note Ensure that the vertex exists, and it has at least `d` edges.
    */
   inline void setDegreeUnsafe(K u, K d) {
+    if (d < degrees[u]) thawEdges(u);
     degrees[u] = d;
   }
 
@@ -796,7 +891,7 @@ class ArenaDiGraph {
       K cap = allocationCapacity(degrees[u]);
       pair<K, E> *tmp = allocate(cap);
       if (i>0) std::memcpy(tmp, edges[u], i*EDGE);
-      if (i>0) deallocate(edges[u], capacities[u]);
+      if (i>0) releaseEdges(u);
       edges[u] = tmp;
       capacities[u] = cap;
     }
@@ -818,9 +913,12 @@ class ArenaDiGraph {
   inline size_t removeEdges(K u, I ib, I ie, FL fl) {
     if (!hasVertex(u)) return 0;
     auto *eb = edges[u], *ee = edges[u] + degrees[u];
-    auto  it = std::set_difference(eb, ee, ib, ie, eb, fl);
-    degrees[u] = it - eb;
-    return ee - it;
+    // Write to a new block, if the edges are shared with a snapshot.
+    auto *ob = frozen[u]? allocate(capacities[u]) : eb;
+    auto  it = std::set_difference(eb, ee, ib, ie, ob, fl);
+    if (ob != eb) { releaseEdges(u); edges[u] = ob; }
+    degrees[u] = it - ob;
+    return (ee - eb) - (it - ob);
   }
 
 
@@ -856,7 +954,7 @@ class ArenaDiGraph {
     pair<K, E> *ptr = allocate(cap);
     auto fl = [](const auto& a, const auto& b) { return a.first <  b.first; };
     auto it = std::set_union(eb, ee, ib, ie, ptr, fl);
-    deallocate(eb, capacities[u]);
+    releaseEdges(u);
     edges[u]   = ptr;
     degrees[u] = it - ptr;
     capacities[u] = cap;
@@ -874,6 +972,98 @@ class ArenaDiGraph {
   #pragma endregion
 
 
+  #pragma region SNAPSHOT
+  public:
+  /**
+   * Check if the graph is a read-only view, sharing the edges of another graph.
+   * @returns is the graph a view?
+   */
+  inline bool isView() const noexcept {
+    return view;
+  }
+
+
+  /**
+   * Share the graph with a read-only view, and mark its edges copy-on-write.
+   * The view copies only the per-vertex arrays, and points to the same edges.
+   * Later updates to this graph copy the edges of a vertex before modifying
+   * them, and retire the shared edges instead of freeing them.
+   * @param a output view (updated)
+   */
+  inline void snapshotW(ArenaDiGraph& a) {
+    constexpr size_t B = 8 * sizeof(bool_type);
+    setupAllocator();
+    a.clear();
+    a.mx = mx;
+    a.resizeArrays(SPAN);
+    std::copy(exists, exists + ceilDiv(SPAN, B), a.exists);
+    std::copy(edges, edges + SPAN, a.edges);
+    std::copy(degrees, degrees + SPAN, a.degrees);
+    std::copy(capacities, capacities + SPAN, a.capacities);
+    std::copy(values, values + SPAN, a.values);
+    a.N = N; a.M = M;
+    a.view = true;
+    for (K u=0; u<SPAN; ++u)
+      frozen[u] = edges[u]!=nullptr;
+#ifdef _OPENMP
+    retired.resize(max(retired.size(), size_t(omp_get_max_threads())));
+#else
+    retired.resize(max(retired.size(), size_t(1)));
+#endif
+  }
+
+
+  /**
+   * Share the graph with a read-only view, and mark its edges copy-on-write [parallel].
+   * The view copies only the per-vertex arrays, and points to the same edges.
+   * Later updates to this graph copy the edges of a vertex before modifying
+   * them, and retire the shared edges instead of freeing them.
+   * @param a output view (updated)
+   */
+  inline void snapshotOmpW(ArenaDiGraph& a) {
+    constexpr size_t B = 8 * sizeof(bool_type);
+    setupAllocator();
+    a.clearOmp();
+    a.mx = mx;
+    a.resizeArraysOmp(SPAN);
+    size_t X = ceilDiv(SPAN, B);
+    #pragma omp parallel for schedule(static, 2048)
+    for (size_t i=0; i<X; ++i)
+      a.exists[i] = exists[i];
+    #pragma omp parallel for schedule(static, 2048)
+    for (K u=0; u<SPAN; ++u) {
+      a.edges[u]      = edges[u];
+      a.degrees[u]    = degrees[u];
+      a.capacities[u] = capacities[u];
+      a.values[u]     = values[u];
+      frozen[u] = edges[u]!=nullptr;
+    }
+    a.N = N; a.M = M;
+    a.view = true;
+#ifdef _OPENMP
+    retired.resize(max(retired.size(), size_t(omp_get_max_threads())));
+#else
+    retired.resize(max(retired.size(), size_t(1)));
+#endif
+  }
+
+
+  /**
+   * Move out the edges retired since they were shared with a snapshot.
+   * @param a retired edges {pointer, bytes} (updated)
+   * @note Retired edges must be freed with `allocator()`, once no view uses them.
+   */
+  inline void collectRetiredU(vector<pair<void*, size_t>>& a) {
+    for (auto& r : retired) {
+      a.insert(a.end(), r.begin(), r.end());
+      r.clear();
+    }
+    a.insert(a.end(), retiredRest.begin(), retiredRest.end());
+    retiredRest.clear();
+  }
+  #pragma endregion
+
+
   #pragma region CONSTRUCTORS
   public:
   /**
@@ -892,6 +1082,7 @@ class ArenaDiGraph {
     delete[] degrees;
     delete[] capacities;
     delete[] values;
+    delete[] frozen;
     mx = nullptr;
   }
   #pragma endregion
@@ -1300,6 +1491,8 @@ class DiGraphCsr {
   size_t CAPACITY = 0;
   /** Vertex values. */
   V *values = nullptr;
+  /** Does the graph own its arrays (false if it points into external memory, e.g., a snapshot)? */
+  bool owned = true;
   #pragma endregion
 
 
@@ -1516,20 +1709,53 @@ class DiGraphCsr {
    * Free the memory allocated for the CSR representation of the graph.
    */
   inline void freeArrays() {
-    delete offsets;
-    delete degrees;
-    delete edgeKeys;
-    delete edgeValues;
-    delete values;
+    if (owned) {
+      delete[] offsets;
+      delete[] degrees;
+      delete[] edgeKeys;
+      delete[] edgeValues;
+      delete[] values;
+    }
+    offsets    = nullptr;
+    degrees    = nullptr;
+    edgeKeys   = nullptr;
+    edgeValues = nullptr;
+    values     = nullptr;
   }
 
 
   public:
+  /**
+   * Point the graph to external arrays, which it does not own (e.g., a memory mapped snapshot).
+   * @param offs offsets of the outgoing edges of vertices (n+1 entries)
+   * @param degs degree of each vertex (n entries)
+   * @param keys vertex ids of the outgoing edges (m entries)
+   * @param ws edge weights of the outgoing edges (m entries)
+   * @param vs vertex values (n entries)
+   * @param n span of the graph
+   * @param m capacity of the graph
+   * @note The arrays held before are freed. The external arrays must outlive the
+   * graph, and the graph can no longer be resized.
+   */
+  inline void viewArrays(O *offs, K *degs, K *keys, E *ws, V *vs, size_t n, size_t m) {
+    freeArrays();
+    offsets    = offs;
+    degrees    = degs;
+    edgeKeys   = keys;
+    edgeValues = ws;
+    values     = vs;
+    SPAN     = n;
+    CAPACITY = m;
+    owned    = false;
+  }
+
+
   /**
    * Adjust the order of the graph (or the number of vertices).
    * @param n new order, or number of vertices
    */
   inline void resize(size_t n) {
+    if (!owned) throw std::logic_error("Cannot resize a graph that does not own its arrays");
     if (n <= SPAN) return;
     freeArrays();
     offsets  = new O[n+1];
@@ -1545,7 +1771,8 @@ class DiGraphCsr {
    * @param m new size, or number of edges
    */
   inline void resize(size_t n, size_t m) {
-    if (n <= SPAN && m <= size()) return;
+    if (!owned) throw std::logic_error("Cannot resize a graph that does not own its arrays");
+    if (offsets && n <= SPAN && m <= CAPACITY) { SPAN = n; return; }
     freeArrays();
     offsets  = new O[n+1];
     degrees  = new K[n];
@@ -1854,6 +2081,317 @@ class DiGraphCsrVector {
   }
   #pragma endregion
 };
+
+
+
+
+/**
+ * A directed graph with compressed CSR representation.
+ * The sorted target vertex ids of each vertex are stored as varint-encoded
+ * gaps (the first one as is), each followed by its raw edge weight, if any.
+ * @tparam K key type (vertex id)
+ * @tparam V vertex value type (vertex data)
+ * @tparam E edge value type (edge weight)
+ * @tparam O offset type
+ */
+template <class K=uint32_t, class V=None, class E=None, class O=size_t>
+class DiGraphCsrCompressed {
+  #pragma region TYPES
+  public:
+  /** Key type (vertex id). */
+  using key_type = K;
+  /** Vertex value type (vertex data). */
+  using vertex_value_type = V;
+  /** Edge value type (edge weight). */
+  using edge_value_type = E;
+  /** Offset type (byte offset). */
+  using offset_type = O;
+  #pragma endregion
+
+
+  #pragma region CONSTANTS
+  public:
+  /** Are edge weights stored? */
+  static constexpr bool WEIGHTED = !std::is_empty_v<E>;
+  #pragma endregion
+
+
+  #pragma region DATA
+  public:
+  /** Byte offsets of the outgoing edges of vertices. */
+  vector<O> offsets;
+  /** Degree of each vertex. */
+  vector<K> degrees;
+  /** Vertex values. */
+  vector<V> values;
+  /** Encoded outgoing edges of each vertex (lookup using offsets). */
+  vector<uint8_t> data;
+  #pragma endregion
+
+
+  #pragma region METHODS
+  #pragma region PROPERTIES
+  public:
+  /**
+   * Get the size of buffer required to store data associated with each vertex
+   * in the graph, indexed by its vertex-id.
+   * @returns size of buffer required
+   */
+  inline size_t span() const noexcept {
+    return degrees.size();
+  }
+
+  /**
+   * Get the number of vertices in the graph.
+   * @returns |V|
+   */
+  inline size_t order() const noexcept {
+    return degrees.size();
+  }
+
+  /**
+   * Obtain the number of edges in the graph.
+   * @returns |E|
+   */
+  inline size_t size() const noexcept {
+    size_t M = 0;
+    for (auto d : degrees)
+      M += d;
+    return M;
+  }
+
+  /**
+   * Get the number of bytes used by the encoded edges.
+   * @returns size of encoded edges [bytes]
+   */
+  inline size_t bytes() const noexcept {
+    return data.size();
+  }
+
+  /**
+   * Check if the graph is empty.
+   * @returns is the graph empty?
+   */
+  inline bool empty() const noexcept {
+    return degrees.empty();
+  }
+
+  /**
+   * Check if the graph is directed.
+   * @returns is the graph directed?
+   */
+  inline bool directed() const noexcept {
+    return true;
+  }
+  #pragma endregion
+
+
+  #pragma region FOREACH
+  public:
+  /**
+   * Iterate over the vertices in the graph.
+   * @param fp process function (vertex id, vertex data)
+   */
+  template <class FP>
+  inline void forEachVertex(FP fp) const noexcept {
+    for (K u=0; u<span(); ++u)
+      fp(u, values[u]);
+  }
+
+  /**
+   * Iterate over the vertex ids in the graph.
+   * @param fp process function (vertex id)
+   */
+  template <class FP>
+  inline void forEachVertexKey(FP fp) const noexcept {
+    for (K u=0; u<span(); ++u)
+      fp(u);
+  }
+
+  /**
+   * Iterate over the outgoing edges of a source vertex in the graph.
+   * @param u source vertex id
+   * @param fp process function (target vertex id, edge weight)
+   */
+  template <class FP>
+  inline void forEachEdge(K u, FP fp) const noexcept {
+    const uint8_t *p = data.data() + offsets[u];
+    uint64_t v = 0, g = 0;
+    for (size_t i=0, I=degrees[u]; i<I; ++i) {
+      p = readVarintW(g, p); v += g;
+      E w = E();
+      if constexpr (WEIGHTED) { std::memcpy(&w, p, sizeof(E)); p += sizeof(E); }
+      fp(K(v), w);
+    }
+  }
+
+  /**
+   * Iterate over the target vertex ids of a source vertex in the graph.
+   * @param u source vertex id
+   * @param fp process function (target vertex id)
+   */
+  template <class FP>
+  inline void forEachEdgeKey(K u, FP fp) const noexcept {
+    const uint8_t *p = data.data() + offsets[u];
+    uint64_t v = 0, g = 0;
+    for (size_t i=0, I=degrees[u]; i<I; ++i) {
+      p = readVarintW(g, p); v += g;
+      if constexpr (WEIGHTED) p += sizeof(E);
+      fp(K(v));
+    }
+  }
+  #pragma endregion
+
+
+  #pragma region ACCESS
+  public:
+  /**
+   * Check if a vertex exists in the graph.
+   * @param u vertex id
+   * @returns does the vertex exist?
+   */
+  inline bool hasVertex(K u) const noexcept {
+    return u < span();
+  }
+
+  /**
+   * Check if an edge exists in the graph.
+   * @param u source vertex id
+   * @param v target vertex id
+   * @returns does the edge exist?
+   */
+  inline bool hasEdge(K u, K v) const noexcept {
+    if (!hasVertex(u)) return false;
+    bool has = false;
+    forEachEdgeKey(u, [&](auto t) { has |= t==v; });
+    return has;
+  }
+
+  /**
+   * Get the number of outgoing edges of a vertex in the graph.
+   * @param u vertex id
+   * @returns number of outgoing edges of the vertex
+   */
+  inline size_t degree(K u) const noexcept {
+    return u < span()? degrees[u] : 0;
+  }
+
+  /**
+   * Get the vertex data of a vertex in the graph.
+   * @param u vertex id
+   * @returns associated data of the vertex
+   */
+  inline V vertexValue(K u) const noexcept {
+    return u < span()? values[u] : V();
+  }
+
+  /**
+   * Set the vertex data of a vertex in the graph.
+   * @param u vertex id
+   * @param d associated data of the vertex
+   * @returns success?
+   */
+  inline bool setVertexValue(K u, V d) noexcept {
+    if (!hasVertex(u)) return false;
+    values[u] = d;
+    return true;
+  }
+
+  /**
+   * Get the edge weight of an edge in the graph.
+   * @param u source vertex id
+   * @param v target vertex id
+   * @returns associated weight of the edge
+   */
+  inline E edgeValue(K u, K v) const noexcept {
+    if (!hasVertex(u)) return E();
+    E a = E();
+    forEachEdge(u, [&](auto t, auto w) { if (t==v) a = w; });
+    return a;
+  }
+  #pragma endregion
+
+
+  #pragma region UPDATE
+  public:
+  /**
+   * Adjust the span of the graph (or the number of vertices).
+   * @param n new span
+   */
+  inline void respan(size_t n) {
+    offsets.resize(n+1);
+    degrees.resize(n);
+    values.resize(n);
+  }
+
+
+  /**
+   * Adjust the order and encoded size of the graph.
+   * @param n new order, or number of vertices
+   * @param b new size of encoded edges [bytes]
+   */
+  inline void resize(size_t n, size_t b) {
+    respan(n);
+    data.resize(b);
+  }
+  #pragma endregion
+  #pragma endregion
+
+
+  #pragma region CONSTRUCTORS
+  public:
+  /**
+   * Create an empty compressed CSR representation of a directed graph.
+   */
+  DiGraphCsrCompressed() {}
+
+
+  /**
+   * Allocate space for compressed CSR representation of a directed graph.
+   * @param n number of vertices
+   * @param b size of encoded edges [bytes]
+   */
+  DiGraphCsrCompressed(size_t n, size_t b) {
+    resize(n, b);
+  }
+  #pragma endregion
+};
+#pragma endregion
+
+
+
+
+#pragma region TRAITS
+/**
+ * Check if a graph type is a DiGraphCsr, i.e., has raw CSR arrays.
+ * @tparam G graph type
+ */
+template <class G>
+struct IsDiGraphCsr : std::false_type {};
+
+template <class K, class V, class E, class O>
+struct IsDiGraphCsr<DiGraphCsr<K, V, E, O>> : std::true_type {};
+
+
+/** Is the graph type a DiGraphCsr? */
+template <class G>
+constexpr bool isDiGraphCsr = IsDiGraphCsr<G>::value;
+
+
+/**
+ * Check if a graph type is an ArenaDiGraph, i.e., has contiguous edges per vertex.
+ * @tparam G graph type
+ */
+template <class G>
+struct IsArenaDiGraph : std::false_type {};
+
+template <class K, class V, class E>
+struct IsArenaDiGraph<ArenaDiGraph<K, V, E>> : std::true_type {};
+
+
+/** Is the graph type an ArenaDiGraph? */
+template <class G>
+constexpr bool isArenaDiGraph = IsArenaDiGraph<G>::value;
 #pragma endregion
 #pragma endregion
 
@@ -2279,6 +2817,12 @@ EXPORT namespace gve {
   using detail::ArenaDiGraph;
   using detail::DiGraph;
   using detail::DiGraphCsr;
+  using detail::DiGraphCsrCompressed;
+  // Traits
+  using detail::IsDiGraphCsr;
+  using detail::isDiGraphCsr;
+  using detail::IsArenaDiGraph;
+  using detail::isArenaDiGraph;
   // Methods (set operations)
   using detail::subtractGraphEdgesU;
   using detail::subtractGraphW;
@@ -0,0 +1,214 @@
+// Copyright (C) 2025 Subhajit Sahu
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// See LICENSE for full terms
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "_compile.hxx"
+
+
+
+
+// An internal namespace helps to hide implementation details.
+// This is particularly useful for pre-C++20 modules.
+namespace gve {
+namespace detail {
+using std::vector;
+
+
+
+
+#pragma region CLASSES
+/**
+ * Accumulator of values by key, for scanning the neighborhood of a vertex.
+ * Keys are stored in a small open-addressing table, which grows with the
+ * number of distinct keys. Only when that approaches the key range (hubs),
+ * or when the key range is small enough to fit in cache, a dense table is
+ * used instead. Thus, memory scales with the maximum number of distinct
+ * keys scanned, rather than the key range.
+ * @tparam K key type (< key range)
+ * @tparam V value type
+ */
+template <class K, class V>
+class ScanAccumulator {
+  #pragma region TYPES
+  public:
+  /** Key type. */
+  using key_type = K;
+  /** Value type. */
+  using value_type = V;
+  #pragma endregion
+
+
+  #pragma region CONSTANTS
+  protected:
+  /** Marker for an empty slot. */
+  static constexpr K EMPTY = K(-1);
+  /** Initial capacity of open-addressing table. */
+  static constexpr size_t MIN_CAPACITY = 16;
+  /** Size of dense table that is always acceptable [bytes] (fits in cache). */
+  static constexpr size_t DENSE_BYTES = size_t(1) << 22;
+  #pragma endregion
+
+
+  #pragma region DATA
+  protected:
+  /** Keys in open-addressing table. */
+  vector<K> keys;
+  /** Values in open-addressing table. */
+  vector<V> values;
+  /** Values in dense table (for hubs). */
+  vector<V> dense;
+  /** Occupied slots (open-addressing), or keys (dense). */
+  vector<K> used;
+  /** Range of keys. */
+  size_t span = 0;
+  /** Log2 of capacity of open-addressing table. */
+  int bits = 0;
+  /** Is the dense table in use? */
+  bool isDense = false;
+  #pragma endregion
+
+
+  #pragma region METHODS
+  protected:
+  /**
+   * Find the slot of a key in open-addressing table.
+   * @param k key
+   * @returns slot of key, or an empty slot where it can be inserted
+   */
+  inline size_t findSlot(K k) const noexcept {
+    size_t mask = keys.size() - 1;
+    size_t i = size_t((uint64_t(k) * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+    while (keys[i] != k && keys[i] != EMPTY)
+      i = (i + 1) & mask;
+    return i;
+  }
+
+  /**
+   * Get a reference to the value of a key in dense table, inserting it if absent.
+   * @param k key
+   * @returns reference to value
+   */
+  inline V& denseAt(K k) {
+    V& a = dense[k];
+    if (a == V()) used.push_back(k);
+    return a;
+  }
+
+  /**
+   * Grow the open-addressing table, or move to the dense table.
+   */
+  inline void grow() {
+    size_t n = keys.empty()? MIN_CAPACITY : 2 * keys.size();
+    // Use the dense table, if it is not much larger.
+    if (n >= span) {
+      if (dense.size() < span) dense.resize(span);
+      for (K& i : used) {
+        K k = keys[i];
+        dense[k]  = values[i];
+        keys[i]   = EMPTY;
+        values[i] = V();
+        i = k;
+      }
+      isDense = true;
+      return;
+    }
+    vector<K> ks(n, EMPTY);
+    vector<V> vs(n);
+    ks.swap(keys);
+    vs.swap(values);
+    for (bits=0; (size_t(1) << bits) < n; ++bits);
+    for (K& i : used) {
+      size_t j  = findSlot(ks[i]);
+      keys[j]   = ks[i];
+      values[j] = vs[i];
+      i = K(j);
+    }
+  }
+
+
+  public:
+  /**
+   * Get the number of distinct keys accumulated.
+   * @returns number of keys
+   */
+  inline size_t size() const noexcept {
+    return used.size();
+  }
+
+  /**
+   * Get the accumulated value of a key.
+   * @param k key
+   * @returns accumulated value, or V() if key is absent
+   */
+  inline V operator[](K k) const noexcept {
+    if (isDense) return dense[k];
+    if (keys.empty()) return V();
+    size_t i = findSlot(k);
+    return keys[i] == k? values[i] : V();
+  }
+
+  /**
+   * Get a reference to the accumulated value of a key, inserting it if absent.
+   * @param k key
+   * @returns reference to accumulated value
+   */
+  inline V& operator[](K k) {
+    if (isDense) return denseAt(k);
+    if (2 * (used.size() + 1) > keys.size()) {
+      grow();
+      if (isDense) return denseAt(k);
+    }
+    size_t i = findSlot(k);
+    if (keys[i] == EMPTY) { keys[i] = k; used.push_back(K(i)); }
+    return values[i];
+  }
+
+  /**
+   * Remove all keys.
+   */
+  inline void clear() noexcept {
+    if (isDense) {
+      for (K k : used)
+        dense[k] = V();
+    }
+    else {
+      for (K i : used) {
+        keys[i]   = EMPTY;
+        values[i] = V();
+      }
+    }
+    used.clear();
+    isDense = span * sizeof(V) <= DENSE_BYTES;
+  }
+  #pragma endregion
+
+
+  #pragma region CONSTRUCTORS
+  public:
+  /**
+   * Create an accumulator for a range of keys.
+   * @param span range of keys
+   */
+  ScanAccumulator(size_t span)
+  : span(span) {
+    if (span * sizeof(V) > DENSE_BYTES) return;
+    dense.resize(span);
+    isDense = true;
+  }
+  #pragma endregion
+};
+#pragma endregion
+} // namespace detail
+} // namespace gve
+
+
+
+
+// Now, we export the public API.
+EXPORT namespace gve {
+  // Classes
+  using detail::ScanAccumulator;
+} // namespace gve
@@ -20,9 +20,13 @@
 #endif
 
 
-// Check for constexpr support.
+// Check for constexpr support (C++17 is required above, if unknown).
+#if defined(__has_feature)
 #if __has_feature(constexpr)
 #define IF_CONSTEXPR if constexpr
 #else
 #define IF_CONSTEXPR if
 #endif
+#else
+#define IF_CONSTEXPR if constexpr
+#endif
@@ -16,6 +16,8 @@
 #include "_vector.hxx"
 #include "_queue.hxx"
 #include "_bitset.hxx"
+#include "_accumulator.hxx"
+#include "_profile.hxx"
 #include "_mman.hxx"
 #include "_memory.hxx"
 #ifdef _OPENMP
@@ -384,6 +384,8 @@ class ConcurrentPow2Allocator {
   #pragma region DATA
   protected:
   vector<Pow2Allocator<CAPACITY>*> a;
+  /** Shared pool for threads beyond those at construction. */
+  Pow2Allocator<CAPACITY> *r = nullptr;
   #pragma endregion
 
 
@@ -405,8 +407,17 @@ class ConcurrentPow2Allocator {
    * @returns allocated memory, or nullptr if out of memory
    */
   inline void* allocate(size_t n) {
+#ifdef _OPENMP
     int t = omp_get_thread_num();
-    return a[t]->allocate(n);
+#else
+    int t = 0;
+#endif
+    if (t < int(a.size())) return a[t]->allocate(n);
+    void *ptr = nullptr;
+    // More threads than at construction.
+    #pragma omp critical (ConcurrentPow2AllocatorRest)
+    ptr = r->allocate(n);
+    return ptr;
   }
 
 
@@ -416,8 +427,15 @@ class ConcurrentPow2Allocator {
    * @param n number of bytes allocated
    */
   inline void deallocate(void *ptr, size_t n) {
+#ifdef _OPENMP
     int t = omp_get_thread_num();
-    a[t]->deallocate(ptr, n);
+#else
+    int t = 0;
+#endif
+    if (t < int(a.size())) { a[t]->deallocate(ptr, n); return; }
+    // More threads than at construction.
+    #pragma omp critical (ConcurrentPow2AllocatorRest)
+    r->deallocate(ptr, n);
   }
 
 
@@ -428,6 +446,7 @@ class ConcurrentPow2Allocator {
     int T = a.size();
     for (int t=0; t<T; ++t)
       a[t]->reset();
+    r->reset();
   }
   #pragma endregion
 
@@ -438,10 +457,15 @@ class ConcurrentPow2Allocator {
    * Create a fast thread-safe power-of-two size allocator.
    */
   ConcurrentPow2Allocator() {
+#ifdef _OPENMP
     int T = omp_get_max_threads();
+#else
+    int T = 1;
+#endif
     a.resize(T);
     for (int t=0; t<T; ++t)
       a[t] = new Pow2Allocator<CAPACITY>();
+    r = new Pow2Allocator<CAPACITY>();
   }
 
   /**
@@ -452,6 +476,7 @@ class ConcurrentPow2Allocator {
     int T = a.size();
     for (int t=0; t<T; ++t)
       delete a[t];
+    delete r;
   }
   #pragma endregion
 };
@@ -8,6 +8,7 @@
 #include <ctime>
 #include <cstdio>
 // #include <cstdlib>
+#include <type_traits>
 #include <mpi.h>
 #include "_debug.hxx"
 
@@ -133,6 +134,28 @@ inline int mpi_comm_rank(MPI_Comm comm=MPI_COMM_WORLD) {
   int rank; MPI_Comm_rank(comm, &rank);
   return rank;
 }
+
+
+/**
+ * Get the MPI datatype of a C++ type.
+ * @tparam T a floating point or integer type
+ * @returns the datatype
+ */
+template <class T>
+inline MPI_Datatype mpi_data_type() {
+  if constexpr (std::is_same_v<T, float>)  return MPI_FLOAT;
+  else if constexpr (std::is_same_v<T, double>) return MPI_DOUBLE;
+  else if constexpr (std::is_same_v<T, long double>) return MPI_LONG_DOUBLE;
+  else if constexpr (std::is_same_v<T, bool>) return MPI_CXX_BOOL;
+  else {
+    static_assert(std::is_integral_v<T>, "Unsupported MPI datatype");
+    constexpr bool S = std::is_signed_v<T>;
+    if constexpr (sizeof(T)==1) return S? MPI_INT8_T  : MPI_UINT8_T;
+    else if constexpr (sizeof(T)==2) return S? MPI_INT16_T : MPI_UINT16_T;
+    else if constexpr (sizeof(T)==4) return S? MPI_INT32_T : MPI_UINT32_T;
+    else return S? MPI_INT64_T : MPI_UINT64_T;
+  }
+}
 }
 }
 #pragma endregion
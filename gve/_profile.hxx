@@ -0,0 +1,255 @@
+// Copyright (C) 2025 Subhajit Sahu
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// See LICENSE for full terms
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+#include <ostream>
+#include "_compile.hxx"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+
+
+#pragma region GVE_PROFILE
+#ifndef GVE_PROFILE
+/** Record per-pass/per-iteration statistics of algorithms? (0 or 1) */
+#define GVE_PROFILE  0
+#endif
+
+#if GVE_PROFILE
+/** Perform only if profiling is enabled. */
+#define GVE_PROFILE_DO(...)  __VA_ARGS__
+#else
+/** Perform only if profiling is enabled. */
+#define GVE_PROFILE_DO(...)
+#endif
+#pragma endregion
+
+
+
+
+// An internal namespace helps to hide implementation details.
+// This is particularly useful for pre-C++20 modules.
+namespace gve {
+namespace detail {
+using std::vector;
+
+
+
+
+#pragma region CLASSES
+/**
+ * Statistics of a phase, or of an iteration within a phase, of an algorithm.
+ */
+struct ProfileRecord {
+  #pragma region DATA
+  /** Name of phase. */
+  const char *phase = "";
+  /** Pass number (0 if not applicable). */
+  int    pass = 0;
+  /** Iteration number within phase (-1 for whole phase). */
+  int    iteration = -1;
+  /** Time spent in milliseconds. */
+  float  time = 0;
+  /** Number of vertices processed. */
+  size_t affected = 0;
+  /** Number of vertices that changed (moved to another community, or changed rank). */
+  size_t changed = 0;
+  /** Number of edges scanned. */
+  size_t edges = 0;
+  /** Number of vertices in the (aggregated) graph. */
+  size_t order = 0;
+  /** Number of edges in the (aggregated) graph. */
+  size_t size = 0;
+  /** Ratio of maximum to mean busy time of threads (1 if balanced, 0 if unknown). */
+  float  imbalance = 0;
+  #pragma endregion
+};
+
+
+
+
+/**
+ * Log of statistics recorded during a run of an algorithm.
+ * Recording is compiled in only with GVE_PROFILE=1; otherwise the log stays
+ * empty, and costs nothing.
+ */
+class ProfileLog {
+  #pragma region TYPES
+  protected:
+  /** Counters of a thread, on their own cache line. */
+  struct alignas(64) ProfileSlot {
+    size_t affected = 0;
+    size_t changed  = 0;
+    size_t edges    = 0;
+    float  time     = 0;
+  };
+  #pragma endregion
+
+
+  #pragma region DATA
+  public:
+  /** Recorded statistics, in order. */
+  vector<ProfileRecord> records;
+  /** Current pass number. */
+  int pass = 0;
+
+  protected:
+  /** Counters of each thread, for the current iteration. */
+  vector<ProfileSlot> slots;
+  #pragma endregion
+
+
+  #pragma region METHODS
+  public:
+  /**
+   * Check if nothing has been recorded.
+   * @returns is the log empty?
+   */
+  inline bool empty() const noexcept {
+    return records.empty();
+  }
+
+  /**
+   * Remove all records.
+   */
+  inline void clear() noexcept {
+    records.clear();
+    pass = 0;
+    for (auto& s : slots)
+      s = ProfileSlot();
+  }
+
+
+  /**
+   * Add to the counters of a thread.
+   * @param t thread id
+   * @param affected number of vertices processed
+   * @param changed number of vertices that changed
+   * @param edges number of edges scanned
+   * @param time busy time of thread in milliseconds
+   * @note Each thread must update only its own counters.
+   */
+  inline void countU(int t, size_t affected, size_t changed, size_t edges, float time) noexcept {
+    if (size_t(t) >= slots.size()) return;
+    ProfileSlot& s = slots[t];
+    s.affected += affected;
+    s.changed  += changed;
+    s.edges    += edges;
+    s.time     += time;
+  }
+
+
+  /**
+   * Record statistics of a phase.
+   * @param phase name of phase
+   * @param iteration iteration number within phase (-1 for whole phase)
+   * @param time time spent in milliseconds
+   * @param order number of vertices in graph
+   * @param size number of edges in graph
+   */
+  inline void record(const char *phase, int iteration, float time, size_t order=0, size_t size=0) {
+    ProfileRecord r;
+    r.phase = phase;
+    r.pass  = pass;
+    r.iteration = iteration;
+    r.time  = time;
+    r.order = order;
+    r.size  = size;
+    records.push_back(r);
+  }
+
+
+  /**
+   * Record statistics of an iteration, gathering the counters of each thread.
+   * @param phase name of phase
+   * @param iteration iteration number within phase
+   * @param time time spent in milliseconds
+   * @note The counters of each thread are reset.
+   */
+  inline void recordThreads(const char *phase, int iteration, float time) {
+    ProfileRecord r;
+    float tmax = 0, tsum = 0;
+    for (auto& s : slots) {
+      r.affected += s.affected;
+      r.changed  += s.changed;
+      r.edges    += s.edges;
+      tmax  = std::max(tmax, s.time);
+      tsum += s.time;
+      s = ProfileSlot();
+    }
+    r.phase = phase;
+    r.pass  = pass;
+    r.iteration = iteration;
+    r.time  = time;
+    r.imbalance = tsum>0? tmax * slots.size() / tsum : 0;
+    records.push_back(r);
+  }
+  #pragma endregion
+
+
+  #pragma region CONSTRUCTORS
+  public:
+  /**
+   * Create an empty log.
+   */
+  ProfileLog() {
+#if GVE_PROFILE
+#ifdef _OPENMP
+    slots.resize(omp_get_max_threads());
+#else
+    slots.resize(1);
+#endif
+#endif
+  }
+  #pragma endregion
+};
+#pragma endregion
+
+
+
+
+#pragma region METHODS
+/**
+ * Write a profile log as JSON.
+ * @param a output stream
+ * @param x profile log
+ */
+inline void writeJson(std::ostream& a, const ProfileLog& x) {
+  a << "[";
+  for (size_t i=0; i<x.records.size(); ++i) {
+    const auto& r = x.records[i];
+    if (i>0) a << ",";
+    a << "\n  {\"phase\": \"" << r.phase << "\""
+      << ", \"pass\": "      << r.pass
+      << ", \"iteration\": " << r.iteration
+      << ", \"time\": "      << r.time
+      << ", \"affected\": "  << r.affected
+      << ", \"changed\": "   << r.changed
+      << ", \"edges\": "     << r.edges
+      << ", \"order\": "     << r.order
+      << ", \"size\": "      << r.size
+      << ", \"imbalance\": " << r.imbalance << "}";
+  }
+  a << (x.records.empty()? "]" : "\n]");
+}
+#pragma endregion
+} // namespace detail
+} // namespace gve
+
+
+
+
+// Now, we export the public API.
+EXPORT namespace gve {
+  // Classes
+  using detail::ProfileRecord;
+  using detail::ProfileLog;
+  // Methods
+  using detail::writeJson;
+} // namespace gve
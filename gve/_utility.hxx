@@ -3,6 +3,7 @@
 // See LICENSE for full terms
 #pragma once
 
+#include <cstdint>
 #include <utility>
 #include <chrono>
 #include "_compile.hxx"
@@ -257,6 +258,58 @@ inline bool retry(F fn, int N=2) {
 
 
 
+#pragma region VARINT
+/**
+ * Get the number of bytes needed to encode a value as a varint (LEB128).
+ * @param x value to encode
+ * @returns number of bytes
+ */
+inline size_t varintSize(uint64_t x) {
+  size_t n = 1;
+  for (; x >= 0x80; x >>= 7)
+    ++n;
+  return n;
+}
+
+
+/**
+ * Encode a value as a varint (LEB128).
+ * @param p output bytes (updated)
+ * @param x value to encode
+ * @returns end of written bytes
+ */
+inline uint8_t* writeVarintU(uint8_t *p, uint64_t x) {
+  for (; x >= 0x80; x >>= 7)
+    *p++ = uint8_t(x | 0x80);
+  *p++ = uint8_t(x);
+  return p;
+}
+
+
+/**
+ * Decode a varint (LEB128) value.
+ * @param a decoded value (output)
+ * @param p input bytes
+ * @returns end of read bytes
+ */
+inline const uint8_t* readVarintW(uint64_t& a, const uint8_t *p) {
+  uint64_t x = *p++;
+  // Most gaps of sorted adjacency lists fit in a single byte.
+  if (x < 0x80) { a = x; return p; }
+  x &= 0x7F;
+  for (int s=7;; s+=7) {
+    uint64_t b = *p++;
+    x |= (b & 0x7F) << s;
+    if (b < 0x80) break;
+  }
+  a = x;
+  return p;
+}
+#pragma endregion
+
+
+
+
 #pragma region MOVE
 /**
  * Conditional move.
@@ -313,4 +366,7 @@ EXPORT namespace gve {
   using detail::measureDurationMarkedMpi;
   #endif
   using detail::retry;
+  using detail::varintSize;
+  using detail::writeVarintU;
+  using detail::readVarintW;
 } // namespace gve
@@ -1868,6 +1868,50 @@ inline TA exclusiveScanOmpW(vector<TA>& a, vector<TA>& buf, const vector<TX>& x,
 }
 #endif
 #pragma endregion
+
+
+
+
+#pragma region SORT VALUES
+/**
+ * Sort values of a vector.
+ * @param a vector (updated)
+ * @param fl less-than comparator (x, y)
+ */
+template <class T, class FL>
+inline void sortValuesU(vector<T>& a, FL fl) {
+  std::sort(a.begin(), a.end(), fl);
+}
+
+
+#ifdef _OPENMP
+/**
+ * Sort values of a vector in parallel.
+ * @param a vector (updated)
+ * @param fl less-than comparator (x, y)
+ * @note Chunks are sorted in parallel, and then merged in pairs, in rounds.
+ */
+template <class T, class FL>
+inline void sortValuesOmpU(vector<T>& a, FL fl) {
+  const size_t SERIAL = 65536;
+  size_t N  = a.size();
+  size_t H  = omp_get_max_threads();
+  auto   ib = a.begin();
+  if (N<=SERIAL || H<=1) { std::sort(ib, a.end(), fl); return; }
+  // Sort chunks of values in parallel.
+  size_t C = (N + H - 1) / H;
+  #pragma omp parallel for schedule(static, 1)
+  for (size_t i=0; i<N; i+=C)
+    std::sort(ib+i, ib+min(i+C, N), fl);
+  // Merge pairs of sorted chunks, in rounds.
+  for (; C<N; C*=2) {
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t i=0; i<N; i+=2*C)
+      std::inplace_merge(ib+i, ib+min(i+C, N), ib+min(i+2*C, N), fl);
+  }
+}
+#endif
+#pragma endregion
 #pragma endregion
 } // namespace detail
 } // namespace gve
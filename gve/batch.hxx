@@ -3,6 +3,8 @@
 // See LICENSE for full terms
 #pragma once
 
+#include <cstdint>
+#include <utility>
 #include <tuple>
 #include <vector>
 #include <random>
@@ -18,7 +20,10 @@
 namespace gve {
 namespace detail {
 using std::tuple;
+using std::pair;
 using std::vector;
+using std::get;
+using std::min;
 
 
 
@@ -150,6 +155,88 @@ inline auto generateEdgeInsertions(R& rnd, const G& x, size_t batchSize, size_t
 
 
 
+#pragma region GENERATE R-MAT
+/**
+ * Generate a random edge of an R-MAT (recursive matrix) graph.
+ * @param rnd random number generator (updated)
+ * @param scale log2 of number of vertices
+ * @param a probability of top-left quadrant [0.57]
+ * @param b probability of top-right quadrant [0.19]
+ * @param c probability of bottom-left quadrant [0.19]
+ * @returns edge {u, v}
+ */
+template <class K, class R, class T>
+inline pair<K, K> generateRmatEdge(R& rnd, int scale, T a, T b, T c) {
+  std::uniform_real_distribution<T> dis(T(0), T(1));
+  K u = K(), v = K();
+  for (int l=0; l<scale; ++l) {
+    T r = dis(rnd);
+    K h = K(1) << l;
+    if (r < a) continue;
+    else if (r < a+b)   v |= h;
+    else if (r < a+b+c) u |= h;
+    else { u |= h; v |= h; }
+  }
+  return {u, v};
+}
+
+
+/**
+ * Generate the edges of an R-MAT (recursive matrix) graph, as in Graph500 Kronecker.
+ * @param rnd random number generator (updated)
+ * @param scale log2 of number of vertices
+ * @param size number of edges
+ * @param w edge weight
+ * @param a probability of top-left quadrant [0.57]
+ * @param b probability of top-right quadrant [0.19]
+ * @param c probability of bottom-left quadrant [0.19]
+ * @returns generated edges {u, v, w}, which may include duplicates and self-loops
+ */
+template <class K=uint32_t, class R, class V>
+inline auto generateRmatEdges(R& rnd, int scale, size_t size, V w, double a=0.57, double b=0.19, double c=0.19) {
+  vector<tuple<K, K, V>> edges(size);
+  for (size_t i=0; i<size; ++i) {
+    auto [u, v] = generateRmatEdge<K>(rnd, scale, a, b, c);
+    edges[i] = {u, v, w};
+  }
+  return edges;
+}
+
+
+#ifdef _OPENMP
+/**
+ * Generate the edges of an R-MAT (recursive matrix) graph in parallel, as in Graph500 Kronecker.
+ * @param seed random seed
+ * @param scale log2 of number of vertices
+ * @param size number of edges
+ * @param w edge weight
+ * @param a probability of top-left quadrant [0.57]
+ * @param b probability of top-right quadrant [0.19]
+ * @param c probability of bottom-left quadrant [0.19]
+ * @returns generated edges {u, v, w}, which may include duplicates and self-loops
+ * @note Each block of edges uses its own seed, so the result does not depend on the number of threads.
+ */
+template <class K=uint32_t, class V>
+inline auto generateRmatEdgesOmp(size_t seed, int scale, size_t size, V w, double a=0.57, double b=0.19, double c=0.19) {
+  const size_t BLOCK = 65536;
+  vector<tuple<K, K, V>> edges(size);
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t i=0; i<size; i+=BLOCK) {
+    std::seed_seq seq{seed, i / BLOCK};
+    std::default_random_engine rnd(seq);
+    for (size_t j=i, J=min(i+BLOCK, size); j<J; ++j) {
+      auto [u, v] = generateRmatEdge<K>(rnd, scale, a, b, c);
+      edges[j] = {u, v, w};
+    }
+  }
+  return edges;
+}
+#endif
+#pragma endregion
+
+
+
+
 #pragma region TIDY BATCH
 /**
  * Filter out edges in batch update by existence.
@@ -183,6 +270,23 @@ inline void sortEdgesByIdU(vector<tuple<K, K, V>>& edges) {
 }
 
 
+#ifdef _OPENMP
+/**
+ * Sort edges in batch update by source/destination vertex in parallel.
+ * @param edges edges in batch update (updated)
+ */
+template <class K, class V>
+inline void sortEdgesByIdOmpU(vector<tuple<K, K, V>>& edges) {
+  auto fl = [](const auto& a, const auto& b) {
+    auto [u1, v1, w1] = a;
+    auto [u2, v2, w2] = b;
+    return u1 < u2 || (u1 == u2 && v1 < v2);
+  };
+  sortValuesOmpU(edges, fl);
+}
+#endif
+
+
 /**
  * Keep only unique edges in batch update.
  * @param edges edges in batch update (updated)
@@ -219,6 +323,76 @@ inline void tidyBatchUpdateU(vector<tuple<K, K, V>>& deletions, vector<tuple<K,
 
 
 
+#pragma region GROUP BATCH
+/**
+ * Group edges in batch update by source vertex.
+ * @param sources unique source vertices (output)
+ * @param offsets offset of targets of each source vertex (output)
+ * @param targets unique target vertices and weights, per source vertex (output)
+ * @param edges edges in batch update, sorted by source/destination vertex
+ * @returns number of source vertices
+ */
+template <class K, class E, class V>
+inline size_t groupEdgesBySourceW(vector<K>& sources, vector<size_t>& offsets, vector<pair<K, E>>& targets, const vector<tuple<K, K, V>>& edges) {
+  size_t N = edges.size();
+  sources.clear();
+  offsets.clear();
+  targets.clear();
+  for (size_t i=0; i<N; ++i) {
+    auto [u, v, w] = edges[i];
+    bool head = i==0 || get<0>(edges[i-1])!=u;
+    bool keep = head || get<1>(edges[i-1])!=v;
+    if (head) { sources.push_back(u); offsets.push_back(targets.size()); }
+    if (keep) targets.push_back({v, E(w)});
+  }
+  offsets.push_back(targets.size());
+  return sources.size();
+}
+
+
+#ifdef _OPENMP
+/**
+ * Group edges in batch update by source vertex in parallel.
+ * @param sources unique source vertices (output)
+ * @param offsets offset of targets of each source vertex (output)
+ * @param targets unique target vertices and weights, per source vertex (output)
+ * @param edges edges in batch update, sorted by source/destination vertex
+ * @returns number of source vertices
+ */
+template <class K, class E, class V>
+inline size_t groupEdgesBySourceOmpW(vector<K>& sources, vector<size_t>& offsets, vector<pair<K, E>>& targets, const vector<tuple<K, K, V>>& edges) {
+  size_t N = edges.size();
+  int    T = omp_get_max_threads();
+  auto fhead = [&](size_t i) { return i==0 || get<0>(edges[i-1])!=get<0>(edges[i]); };
+  auto fkeep = [&](size_t i) { return fhead(i) || get<1>(edges[i-1])!=get<1>(edges[i]); };
+  vector<size_t> hpos(N), kpos(N), buf(T);
+  // Mark the first edge of each source, and the first of duplicate edges.
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t i=0; i<N; ++i) {
+    hpos[i] = fhead(i);
+    kpos[i] = fkeep(i);
+  }
+  // Find the position of each source and each unique edge.
+  size_t S = exclusiveScanOmpW(hpos.data(), buf.data(), hpos.data(), N);
+  size_t M = exclusiveScanOmpW(kpos.data(), buf.data(), kpos.data(), N);
+  sources.resize(S);
+  offsets.resize(S+1);
+  targets.resize(M);
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t i=0; i<N; ++i) {
+    auto [u, v, w] = edges[i];
+    if (fhead(i)) { sources[hpos[i]] = u; offsets[hpos[i]] = kpos[i]; }
+    if (fkeep(i)) targets[kpos[i]] = {v, E(w)};
+  }
+  offsets[S] = M;
+  return S;
+}
+#endif
+#pragma endregion
+
+
+
+
 #pragma region APPLY
 /**
  * Apply a batch update to a graph.
@@ -237,6 +411,64 @@ inline void applyBatchUpdateU(G& a, const vector<tuple<K, K, V>>& deletions, con
 }
 
 
+/**
+ * Ensure that the source and target vertices of grouped edges exist in a graph.
+ * @param a input graph (updated)
+ * @param sources unique source vertices
+ * @param targets target vertices and weights, per source vertex
+ * @returns number of vertices added
+ */
+template <class G, class K, class E>
+inline size_t addBatchVerticesU(G& a, const vector<K>& sources, const vector<pair<K, E>>& targets) {
+  K S = K();
+  for (K u : sources)
+    S = max(S, K(u+1));
+  for (const auto& [v, w] : targets)
+    S = max(S, K(v+1));
+  if (S > a.span()) a.respan(S);
+  size_t n = 0;
+  for (K u : sources)
+    if (!a.hasVertex(u)) { a.addVertex(u); ++n; }
+  for (const auto& [v, w] : targets)
+    if (!a.hasVertex(v)) { a.addVertex(v); ++n; }
+  return n;
+}
+
+
+/**
+ * Apply a batch update to an Arena DiGraph, with grouped per-source merges.
+ * @param a input graph (updated)
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @note Only the vertices in the batch are visited.
+ */
+template <class K, class V, class E, class W>
+inline void applyBatchUpdateU(ArenaDiGraph<K, V, E>& a, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions) {
+  auto fl = [](const auto& x, const auto& y) { return x.first < y.first; };
+  vector<tuple<K, K, W>> edges;
+  vector<K> sources;
+  vector<size_t> offsets;
+  vector<pair<K, E>> targets;
+  size_t N = a.order(), M = a.size();
+  // Remove edges, grouped by source vertex.
+  edges = deletions;
+  sortEdgesByIdU(edges);
+  size_t S = groupEdgesBySourceW(sources, offsets, targets, edges);
+  for (size_t i=0; i<S; ++i)
+    M -= a.removeEdges(sources[i], targets.begin() + offsets[i], targets.begin() + offsets[i+1], fl);
+  // Add edges, grouped by source vertex.
+  edges = insertions;
+  sortEdgesByIdU(edges);
+  S = groupEdgesBySourceW(sources, offsets, targets, edges);
+  N += addBatchVerticesU(a, sources, targets);
+  for (size_t i=0; i<S; ++i)
+    M += a.addEdges(sources[i], targets.begin() + offsets[i], targets.begin() + offsets[i+1]);
+  // Update counts, only with the touched vertices.
+  a.setOrder(N);
+  a.setSize(M);
+}
+
+
 #ifdef _OPENMP
 /**
  * Apply a batch update to a graph.
@@ -253,6 +485,45 @@ inline void applyBatchUpdateOmpU(G& a, const vector<tuple<K, K, V>>& deletions,
     a.addEdge(u, v, w);
   updateOmpU(a);
 }
+
+
+/**
+ * Apply a batch update to an Arena DiGraph, with grouped per-source merges in parallel.
+ * @param a input graph (updated)
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @note Only the vertices in the batch are visited.
+ */
+template <class K, class V, class E, class W>
+inline void applyBatchUpdateOmpU(ArenaDiGraph<K, V, E>& a, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions) {
+  auto fl = [](const auto& x, const auto& y) { return x.first < y.first; };
+  vector<tuple<K, K, W>> edges;
+  vector<K> sources;
+  vector<size_t> offsets;
+  vector<pair<K, E>> targets;
+  size_t N = a.order(), M = a.size();
+  size_t dM = 0;
+  // Remove edges, grouped by source vertex.
+  edges = deletions;
+  sortEdgesByIdOmpU(edges);
+  size_t S = groupEdgesBySourceOmpW(sources, offsets, targets, edges);
+  #pragma omp parallel for schedule(dynamic, 64) reduction(+:dM)
+  for (size_t i=0; i<S; ++i)
+    dM += a.removeEdges(sources[i], targets.begin() + offsets[i], targets.begin() + offsets[i+1], fl);
+  M -= dM; dM = 0;
+  // Add edges, grouped by source vertex.
+  edges = insertions;
+  sortEdgesByIdOmpU(edges);
+  S  = groupEdgesBySourceOmpW(sources, offsets, targets, edges);
+  N += addBatchVerticesU(a, sources, targets);
+  #pragma omp parallel for schedule(dynamic, 64) reduction(+:dM)
+  for (size_t i=0; i<S; ++i)
+    dM += a.addEdges(sources[i], targets.begin() + offsets[i], targets.begin() + offsets[i+1]);
+  M += dM;
+  // Update counts, only with the touched vertices.
+  a.setOrder(N);
+  a.setSize(M);
+}
 #endif
 #pragma endregion
 #pragma endregion
@@ -270,12 +541,19 @@ EXPORT namespace gve {
   using detail::addRandomEdge;
   using detail::generateEdgeDeletions;
   using detail::generateEdgeInsertions;
+  using detail::generateRmatEdge;
+  using detail::generateRmatEdges;
   using detail::filterEdgesByExistenceU;
   using detail::sortEdgesByIdU;
   using detail::uniqueEdgesU;
   using detail::tidyBatchUpdateU;
+  using detail::groupEdgesBySourceW;
+  using detail::addBatchVerticesU;
   using detail::applyBatchUpdateU;
 #ifdef _OPENMP
+  using detail::generateRmatEdgesOmp;
+  using detail::sortEdgesByIdOmpU;
+  using detail::groupEdgesBySourceOmpW;
   using detail::applyBatchUpdateOmpU;
 #endif
 } // namespace gve
@@ -3,9 +3,11 @@
 // See LICENSE for full terms
 #pragma once
 
+#include <cstdint>
 #include <utility>
 #include <vector>
 #include "_main.hxx"
+#include "Graph.hxx"
 
 
 
@@ -16,6 +18,8 @@ namespace gve {
 namespace detail {
 using std::vector;
 using std::swap;
+using std::pair;
+using std::min;
 
 
 
@@ -82,6 +86,300 @@ inline vector<FLAG> bfsVisitedForEach(const G& x, K u, FT ft, FP fp) {
   bfsVisitedForEachU(vis, x, u, ft, fp);
   return vis;
 }
+
+
+/**
+ * Find the distance of each vertex from a start vertex, using BFS.
+ * @param x original graph
+ * @param u start vertex
+ * @returns distance of each vertex (-1 if unreachable)
+ */
+template <class G, class K>
+inline vector<K> bfsDistances(const G& x, K u) {
+  vector<bool> vis(x.span());
+  vector<K>    dis(x.span(), K(-1));
+  auto ft = [ ](auto v, auto d) { return true; };
+  auto fp = [&](auto v, auto d) { dis[v] = d; };
+  bfsVisitedForEachU(vis, x, u, ft, fp);
+  return dis;
+}
+#pragma endregion
+
+
+
+
+#pragma region METHODS (OPENMP)
+#ifdef _OPENMP
+/**
+ * Concatenate per-thread frontiers into a single frontier.
+ * @param vs frontier vertices (output)
+ * @param qs per-thread frontier vertices
+ */
+template <class K>
+inline void bfsMergeFrontiersOmpW(vector<K>& vs, const vector<vector<K>>& qs) {
+  int T = qs.size();
+  vector<size_t> offs(T+1);
+  for (int t=0; t<T; ++t)
+    offs[t+1] = offs[t] + qs[t].size();
+  vs.resize(offs[T]);
+  #pragma omp parallel for schedule(static, 1)
+  for (int t=0; t<T; ++t)
+    copyValuesW(vs.data() + offs[t], qs[t].data(), qs[t].size());
+}
+
+
+/**
+ * Mark start vertices of BFS as visited, and drop the ones not to be visited.
+ * @param vis vertex visited flags (updated)
+ * @param us start vertices (updated)
+ * @param ft should vertex be visited? (vertex, depth)
+ * @param fp action to perform on every visited vertex (vertex, depth)
+ */
+template <class B, class K, class FT, class FP>
+inline void bfsVisitStartU(vector<B>& vis, vector<K>& us, FT ft, FP fp) {
+  size_t n = 0;
+  for (K u : us) {
+    if (vis[u] || !ft(u, K())) continue;
+    vis[u]  = B(1);
+    us[n++] = u;
+    fp(u, K());
+  }
+  us.resize(n);
+}
+
+
+/**
+ * Perform a top-down step of BFS, expanding the frontier along out-edges (using OpenMP).
+ * @param vis vertex visited flags (updated)
+ * @param vs next frontier vertices (output)
+ * @param qs per-thread frontier vertices (scratch)
+ * @param x original graph
+ * @param us current frontier vertices
+ * @param d depth of next frontier
+ * @param ft should vertex be visited? (vertex, depth)
+ * @param fp action to perform on every visited vertex (vertex, depth)
+ * @returns number of out-edges of next frontier
+ */
+template <class B, class G, class K, class FT, class FP>
+inline size_t bfsTopDownStepOmpW(vector<B>& vis, vector<K>& vs, vector<vector<K>>& qs, const G& x, const vector<K>& us, K d, FT ft, FP fp) {
+  size_t U = us.size(), mf = 0;
+  #pragma omp parallel reduction(+:mf)
+  {
+    int t = omp_get_thread_num();
+    qs[t].clear();
+    #pragma omp for schedule(dynamic, 64) nowait
+    for (size_t i=0; i<U; ++i) {
+      x.forEachEdgeKey(us[i], [&](K v) {
+        if (vis[v] || !ft(v, d)) return;
+        B visv;
+        #pragma omp atomic capture
+        { visv = vis[v]; vis[v] = B(1); }
+        if (visv) return;
+        qs[t].push_back(v);
+        mf += x.degree(v);
+        fp(v, d);
+      });
+    }
+  }
+  bfsMergeFrontiersOmpW(vs, qs);
+  return mf;
+}
+
+
+/**
+ * Check if any out-neighbor of a vertex satisfies a test, stopping at the first one [helper function].
+ * @param x given graph
+ * @param u given vertex
+ * @param fp test on each out-neighbor (v)
+ * @returns does any out-neighbor satisfy the test?
+ * @note Stops early only when the edges of a vertex are stored
+ * contiguously (DiGraphCsr, ArenaDiGraph).
+ */
+template <class G, class K, class FP>
+inline bool bfsAnyEdgeKey(const G& x, K u, FP fp) {
+  if constexpr (isDiGraphCsr<G>) {
+    size_t i = x.offsets[u];
+    size_t I = i + x.degrees[u];
+    for (; i<I; ++i)
+      if (fp(x.edgeKeys[i])) return true;
+    return false;
+  }
+  else if constexpr (isArenaDiGraph<G>) {
+    for (auto it=x.beginEdges(u), ie=x.endEdges(u); it!=ie; ++it)
+      if (fp((*it).first)) return true;
+    return false;
+  }
+  else {
+    bool found = false;
+    x.forEachEdgeKey(u, [&](auto v) { if (!found) found = fp(v); });
+    return found;
+  }
+}
+
+
+/**
+ * Perform a bottom-up step of BFS, where each unvisited vertex looks for a parent in the frontier (using OpenMP).
+ * @param vis vertex visited flags (updated)
+ * @param fnxt next frontier bitmap (output)
+ * @param x original graph
+ * @param xt transpose of original graph
+ * @param fcur current frontier bitmap
+ * @param d depth of next frontier
+ * @param ft should vertex be visited? (vertex, depth)
+ * @param fp action to perform on every visited vertex (vertex, depth)
+ * @returns number of vertices, and their out-edges, in next frontier
+ */
+template <class B, class G, class H, class K, class FT, class FP>
+inline pair<size_t, size_t> bfsBottomUpStepOmpW(vector<B>& vis, vector<uint64_t>& fnxt, const G& x, const H& xt, const vector<uint64_t>& fcur, K d, FT ft, FP fp) {
+  size_t S = x.span(), W = fcur.size(), nf = 0, mf = 0;
+  // Each thread owns whole words of the bitmap, so no atomics are needed.
+  #pragma omp parallel for schedule(dynamic, 16) reduction(+:nf, mf)
+  for (size_t w=0; w<W; ++w) {
+    uint64_t bits = 0;
+    K ub = K(w * 64), ue = K(min(S, w * 64 + 64));
+    for (K v=ub; v<ue; ++v) {
+      if (vis[v] || !x.hasVertex(v) || !ft(v, d)) continue;
+      // Stop at the first parent in the frontier.
+      if (!bfsAnyEdgeKey(xt, v, [&](K u) { return getBit(fcur.data(), u); })) continue;
+      vis[v] = B(1);
+      bits |= uint64_t(1) << (v % 64);
+      ++nf; mf += x.degree(v);
+      fp(v, d);
+    }
+    fnxt[w] = bits;
+  }
+  return {nf, mf};
+}
+
+
+/**
+ * Find vertices visited with BFS, expanding top-down only (using OpenMP).
+ * @param vis vertex visited flags (updated)
+ * @param us start vertices (updated)
+ * @param vs frontier vertices (updated)
+ * @param x original graph
+ * @param ft should vertex be visited? (vertex, depth)
+ * @param fp action to perform on every visited vertex (vertex, depth)
+ * @note ft and fp may be called concurrently, for different vertices.
+ */
+template <class B, class G, class K, class FT, class FP>
+inline void bfsVisitedForEachOmpU(vector<B>& vis, vector<K>& us, vector<K>& vs, const G& x, FT ft, FP fp) {
+  int T = omp_get_max_threads();
+  vector<vector<K>> qs(T);
+  bfsVisitStartU(vis, us, ft, fp);
+  for (K d=1; !us.empty(); ++d) {
+    bfsTopDownStepOmpW(vis, vs, qs, x, us, d, ft, fp);
+    swap(us, vs);
+  }
+}
+
+
+/**
+ * Find vertices visited with direction-optimizing BFS (using OpenMP).
+ * @param vis vertex visited flags (updated)
+ * @param us start vertices (updated)
+ * @param vs frontier vertices (updated)
+ * @param x original graph
+ * @param xt transpose of original graph
+ * @param ft should vertex be visited? (vertex, depth)
+ * @param fp action to perform on every visited vertex (vertex, depth)
+ * @note ft and fp may be called concurrently, for different vertices.
+ */
+template <class B, class G, class H, class K, class FT, class FP>
+inline void bfsVisitedForEachOmpU(vector<B>& vis, vector<K>& us, vector<K>& vs, const G& x, const H& xt, FT ft, FP fp) {
+  // Switch to bottom-up when the frontier has more than 1/ALPHA of unexplored
+  // edges, and back to top-down when it has less than 1/BETA of all vertices.
+  const size_t ALPHA = 15, BETA = 18;
+  size_t S = x.span(), N = x.order(), W = ceilDiv(S, size_t(64));
+  int    T = omp_get_max_threads();
+  vector<vector<K>> qs(T);
+  vector<uint64_t> fcur, fnxt;
+  bfsVisitStartU(vis, us, ft, fp);
+  size_t nf = us.size(), mf = 0, mu = x.size();
+  for (K u : us)
+    mf += x.degree(u);
+  mu -= min(mu, mf);
+  bool down = true;
+  for (K d=1; nf>0; ++d) {
+    if (down && mf > mu / ALPHA) {
+      // Convert frontier queue to bitmap.
+      fcur.resize(W); fnxt.resize(W);
+      fillValueOmpU(fcur, uint64_t());
+      size_t U = us.size();
+      #pragma omp parallel for schedule(static, 2048)
+      for (size_t i=0; i<U; ++i) {
+        K u = us[i];
+        #pragma omp atomic
+        fcur[u / 64] |= uint64_t(1) << (u % 64);
+      }
+      down = false;
+    }
+    else if (!down && nf < N / BETA) {
+      // Convert frontier bitmap to queue.
+      #pragma omp parallel
+      {
+        int t = omp_get_thread_num();
+        qs[t].clear();
+        #pragma omp for schedule(static, 256) nowait
+        for (size_t w=0; w<W; ++w) {
+          for (uint64_t bits=fcur[w]; bits; bits &= bits - 1)
+            qs[t].push_back(K(w * 64 + __builtin_ctzll(bits)));
+        }
+      }
+      bfsMergeFrontiersOmpW(us, qs);
+      down = true;
+    }
+    if (down) {
+      mf = bfsTopDownStepOmpW(vis, vs, qs, x, us, d, ft, fp);
+      nf = vs.size();
+      swap(us, vs);
+    }
+    else {
+      auto [nb, mb] = bfsBottomUpStepOmpW(vis, fnxt, x, xt, fcur, d, ft, fp);
+      nf = nb; mf = mb;
+      swap(fcur, fnxt);
+    }
+    mu -= min(mu, mf);
+  }
+  us.clear();
+}
+
+
+/**
+ * Find vertices visited with direction-optimizing BFS (using OpenMP).
+ * @tparam FLAG visited flag type (must support atomic update)
+ * @param x original graph
+ * @param xt transpose of original graph
+ * @param u start vertex
+ * @param ft should vertex be visited? (vertex, depth)
+ * @param fp action to perform on every visited vertex (vertex, depth)
+ * @returns vertex visited flags
+ */
+template <class FLAG=char, class G, class H, class K, class FT, class FP>
+inline vector<FLAG> bfsVisitedForEachOmp(const G& x, const H& xt, K u, FT ft, FP fp) {
+  vector<FLAG> vis(x.span());
+  vector<K> us {u}, vs;
+  bfsVisitedForEachOmpU(vis, us, vs, x, xt, ft, fp);
+  return vis;
+}
+
+
+/**
+ * Find the distance of each vertex from a start vertex, using direction-optimizing BFS (using OpenMP).
+ * @param x original graph
+ * @param xt transpose of original graph
+ * @param u start vertex
+ * @returns distance of each vertex (-1 if unreachable)
+ */
+template <class G, class H, class K>
+inline vector<K> bfsDistancesOmp(const G& x, const H& xt, K u) {
+  vector<K> dis(x.span(), K(-1));
+  auto ft = [ ](auto v, auto d) { return true; };
+  auto fp = [&](auto v, auto d) { dis[v] = d; };
+  bfsVisitedForEachOmp(x, xt, u, ft, fp);
+  return dis;
+}
+#endif
 #pragma endregion
 } // namespace detail
 } // namespace gve
@@ -94,4 +392,10 @@ EXPORT namespace gve {
   // Methods
   using detail::bfsVisitedForEachU;
   using detail::bfsVisitedForEach;
+  using detail::bfsDistances;
+#ifdef _OPENMP
+  using detail::bfsVisitedForEachOmpU;
+  using detail::bfsVisitedForEachOmp;
+  using detail::bfsDistancesOmp;
+#endif
 } // namespace gve
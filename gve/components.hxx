@@ -0,0 +1,457 @@
+// Copyright (C) 2025 Subhajit Sahu
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// See LICENSE for full terms
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "_main.hxx"
+#include "Graph.hxx"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+
+
+// An internal namespace helps to hide implementation details.
+// This is particularly useful for pre-C++20 modules.
+namespace gve {
+namespace detail {
+using std::tuple;
+using std::vector;
+using std::mt19937;
+using std::uniform_int_distribution;
+using std::sort;
+using std::min;
+using std::max;
+
+
+
+
+#pragma region METHODS
+#pragma region ATOMICS
+/**
+ * Atomically load a component label.
+ * @param a component label
+ * @returns value of label
+ */
+template <class K>
+inline K componentsLoad(const K& a) {
+  return __atomic_load_n(&a, __ATOMIC_RELAXED);
+}
+
+
+/**
+ * Atomically store a component label.
+ * @param a component label (updated)
+ * @param v new value of label
+ */
+template <class K>
+inline void componentsStore(K& a, K v) {
+  __atomic_store_n(&a, v, __ATOMIC_RELAXED);
+}
+
+
+/**
+ * Atomically replace a component label, if it has an expected value.
+ * @param a component label (updated)
+ * @param e expected value of label
+ * @param v new value of label
+ * @returns whether label was replaced
+ */
+template <class K>
+inline bool componentsCompareExchange(K& a, K e, K v) {
+  return __atomic_compare_exchange_n(&a, &e, v, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+#pragma endregion
+
+
+
+
+#pragma region FIND
+/**
+ * Find the root of the component of a vertex, in a union-find forest.
+ * @param comp parent of each vertex (union-find forest)
+ * @param u given vertex
+ * @returns component root (lowest vertex id in component)
+ */
+template <class K>
+inline K componentsFind(const vector<K>& comp, K u) {
+  while (comp[u]!=u) u = comp[u];
+  return u;
+}
+
+
+/**
+ * Find the root of the component of a vertex, halving the path to it.
+ * @param comp parent of each vertex (union-find forest, updated)
+ * @param u given vertex
+ * @returns component root (lowest vertex id in component)
+ */
+template <class K>
+inline K componentsFindU(vector<K>& comp, K u) {
+  while (comp[u]!=u) {
+    comp[u] = comp[comp[u]];
+    u = comp[u];
+  }
+  return u;
+}
+
+
+#ifdef _OPENMP
+/**
+ * Find the root of the component of a vertex, while other threads link components (using OpenMP).
+ * @param comp parent of each vertex (union-find forest)
+ * @param u given vertex
+ * @returns component root (lowest vertex id in component)
+ */
+template <class K>
+inline K componentsFindOmp(const vector<K>& comp, K u) {
+  for (K p = componentsLoad(comp[u]); p!=u; p = componentsLoad(comp[u]))
+    u = p;
+  return u;
+}
+#endif
+#pragma endregion
+
+
+
+
+#pragma region LINK
+/**
+ * Join the components of two vertices, in a union-find forest.
+ * @param comp parent of each vertex (union-find forest, updated)
+ * @param u one vertex
+ * @param v other vertex
+ */
+template <class K>
+inline void componentsLinkU(vector<K>& comp, K u, K v) {
+  K ru = componentsFindU(comp, u);
+  K rv = componentsFindU(comp, v);
+  if (ru==rv) return;
+  comp[max(ru, rv)] = min(ru, rv);
+}
+
+
+#ifdef _OPENMP
+/**
+ * Join the components of two vertices, in a union-find forest (lock-free, using OpenMP).
+ * The higher root is hooked onto the lower one with compare-and-swap, so roots
+ * are always the lowest vertex ids, and no cycles can form.
+ * @param comp parent of each vertex (union-find forest, updated)
+ * @param u one vertex
+ * @param v other vertex
+ */
+template <class K>
+inline void componentsLinkOmpU(vector<K>& comp, K u, K v) {
+  K p1 = componentsLoad(comp[u]);
+  K p2 = componentsLoad(comp[v]);
+  while (p1!=p2) {
+    K hi = max(p1, p2);
+    K lo = min(p1, p2);
+    K ph = componentsLoad(comp[hi]);
+    if (ph==lo) break;
+    if (ph==hi && componentsCompareExchange(comp[hi], hi, lo)) break;
+    p1 = componentsLoad(comp[componentsLoad(comp[hi])]);
+    p2 = componentsLoad(comp[lo]);
+  }
+}
+#endif
+#pragma endregion
+
+
+
+
+#pragma region COMPRESS
+/**
+ * Point each vertex directly to the root of its component.
+ * @param comp parent of each vertex (union-find forest, updated)
+ */
+template <class K>
+inline void componentsCompressU(vector<K>& comp) {
+  size_t S = comp.size();
+  for (K u=0; u<S; ++u) {
+    while (comp[u]!=comp[comp[u]])
+      comp[u] = comp[comp[u]];
+  }
+}
+
+
+#ifdef _OPENMP
+/**
+ * Point each vertex directly to the root of its component (using OpenMP).
+ * @param comp parent of each vertex (union-find forest, updated)
+ */
+template <class K>
+inline void componentsCompressOmpU(vector<K>& comp) {
+  size_t S = comp.size();
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (K u=0; u<S; ++u) {
+    K p = componentsLoad(comp[u]);
+    for (K q = componentsLoad(comp[p]); p!=q; q = componentsLoad(comp[p])) {
+      componentsStore(comp[u], q);
+      p = q;
+    }
+  }
+}
+#endif
+#pragma endregion
+
+
+
+
+#pragma region SAMPLE
+/**
+ * Find the most frequent component label, among a random sample of vertices.
+ * @param comp parent of each vertex (union-find forest)
+ * @param n number of vertices to sample
+ * @param seed random seed
+ * @returns most frequent label in sample
+ */
+template <class K>
+inline K componentsSampleFrequent(const vector<K>& comp, size_t n, uint32_t seed=42) {
+  size_t S = comp.size();
+  if (S==0) return K();
+  mt19937 rnd(seed);
+  uniform_int_distribution<size_t> dis(0, S-1);
+  vector<K> a(n);
+  for (size_t i=0; i<n; ++i)
+    a[i] = comp[dis(rnd)];
+  sort(a.begin(), a.end());
+  K cmax = a.empty()? K() : a[0];
+  size_t fmax = 0;
+  for (size_t i=0, j=0; i<n; i=j) {
+    for (j=i+1; j<n && a[j]==a[i]; ++j);
+    if (j-i<=fmax) continue;
+    cmax = a[i];
+    fmax = j-i;
+  }
+  return cmax;
+}
+#pragma endregion
+
+
+
+
+#pragma region COMPONENTS
+/**
+ * Iterate over the first few target vertex ids of a source vertex [helper function].
+ * @param x given graph
+ * @param u source vertex id
+ * @param R number of edges to visit
+ * @param fp process function (target vertex id)
+ * @note Only the first R edges are touched if the graph stores them
+ * contiguously (DiGraphCsr, ArenaDiGraph).
+ */
+template <class G, class K, class FP>
+inline void componentsForEachEdgeKeyFirst(const G& x, K u, int R, FP fp) {
+  if constexpr (isDiGraphCsr<G>) {
+    size_t i = x.offsets[u];
+    size_t I = i + min(size_t(R), size_t(x.degrees[u]));
+    for (; i<I; ++i)
+      fp(x.edgeKeys[i]);
+  }
+  else if constexpr (isArenaDiGraph<G>) {
+    auto ib = x.beginEdges(u);
+    auto ie = ib + min(size_t(R), size_t(x.degree(u)));
+    for (auto it=ib; it!=ie; ++it)
+      fp((*it).first);
+  }
+  else {
+    int i = 0;
+    x.forEachEdgeKey(u, [&](auto v) { if (i++ < R) fp(v); });
+  }
+}
+
+
+/**
+ * Find the weakly connected components of a graph, with union-find.
+ * @param x given graph
+ * @param fe include edge in components? (u, v)
+ * @returns component root (lowest vertex id in component) of each vertex
+ */
+template <class G, class FE>
+inline auto components(const G& x, FE fe) {
+  using  K = typename G::key_type;
+  size_t S = x.span();
+  vector<K> comp(S);
+  for (K u=0; u<S; ++u)
+    comp[u] = u;
+  x.forEachVertexKey([&](auto u) {
+    x.forEachEdgeKey(u, [&](auto v) {
+      if (fe(u, v)) componentsLinkU(comp, u, K(v));
+    });
+  });
+  componentsCompressU(comp);
+  return comp;
+}
+
+
+/**
+ * Find the weakly connected components of a graph, with union-find.
+ * @param x given graph
+ * @returns component root (lowest vertex id in component) of each vertex
+ */
+template <class G>
+inline auto components(const G& x) {
+  auto fe = [](auto u, auto v) { return true; };
+  return components(x, fe);
+}
+
+
+#ifdef _OPENMP
+/**
+ * Find the weakly connected components of a graph, with Afforest (using OpenMP).
+ * First, the first few edges of each vertex are linked, and the forest is
+ * compressed. Then, the most frequent component in a sample of vertices is
+ * found, which is usually the giant component. In a symmetric graph, vertices
+ * already in it need not link their remaining edges, which skips most edges.
+ * @tparam SYMMETRIC is graph symmetric (each edge present in both directions)?
+ * @param x given graph
+ * @param fe include edge in components? (u, v)
+ * @param R number of edges per vertex to link before sampling
+ * @param samples number of vertices to sample for giant component
+ * @returns component root (lowest vertex id in component) of each vertex
+ */
+template <bool SYMMETRIC=false, class G, class FE>
+inline auto componentsOmp(const G& x, FE fe, int R=2, size_t samples=1024) {
+  using  K = typename G::key_type;
+  size_t S = x.span();
+  vector<K> comp(S);
+  #pragma omp parallel for schedule(static, 2048)
+  for (K u=0; u<S; ++u)
+    comp[u] = u;
+  // Link first R edges of each vertex.
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (K u=0; u<S; ++u) {
+    if (!x.hasVertex(u)) continue;
+    componentsForEachEdgeKeyFirst(x, u, R, [&](auto v) {
+      if (fe(u, K(v))) componentsLinkOmpU(comp, u, K(v));
+    });
+  }
+  componentsCompressOmpU(comp);
+  // Link remaining edges, outside the giant component.
+  K c = SYMMETRIC? componentsSampleFrequent(comp, samples) : K(-1);
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (K u=0; u<S; ++u) {
+    if (!x.hasVertex(u) || comp[u]==c) continue;
+    int i = 0;
+    x.forEachEdgeKey(u, [&](auto v) {
+      if (i++ >= R && fe(u, K(v))) componentsLinkOmpU(comp, u, K(v));
+    });
+  }
+  componentsCompressOmpU(comp);
+  return comp;
+}
+
+
+/**
+ * Find the weakly connected components of a graph, with Afforest (using OpenMP).
+ * @tparam SYMMETRIC is graph symmetric (each edge present in both directions)?
+ * @param x given graph
+ * @returns component root (lowest vertex id in component) of each vertex
+ */
+template <bool SYMMETRIC=false, class G>
+inline auto componentsOmp(const G& x) {
+  auto fe = [](auto u, auto v) { return true; };
+  return componentsOmp<SYMMETRIC>(x, fe);
+}
+#endif
+#pragma endregion
+
+
+
+
+#pragma region UPDATE
+/**
+ * Grow a union-find forest to cover the vertices of a batch of edges.
+ * @param comp parent of each vertex (union-find forest, updated)
+ * @param edges batch of edges {u, v, w}
+ */
+template <class K, class V>
+inline void componentsResizeU(vector<K>& comp, const vector<tuple<K, K, V>>& edges) {
+  size_t S = comp.size(), N = S;
+  for (const auto& [u, v, w] : edges)
+    N = max(N, size_t(max(u, v)) + 1);
+  comp.resize(N);
+  for (K u=S; u<N; ++u)
+    comp[u] = u;
+}
+
+
+/**
+ * Update the components of a graph, after a batch of edge insertions.
+ * Only the forest paths of the batch vertices are touched, so other vertices
+ * may point to an older root; use componentsFind() to obtain their component,
+ * or componentsCompressU() to point every vertex to its root.
+ * @param comp parent of each vertex (union-find forest, updated)
+ * @param insertions edge insertions {u, v, w}
+ */
+template <class K, class V>
+inline void componentsInsertU(vector<K>& comp, const vector<tuple<K, K, V>>& insertions) {
+  componentsResizeU(comp, insertions);
+  for (const auto& [u, v, w] : insertions)
+    componentsLinkU(comp, u, v);
+  for (const auto& [u, v, w] : insertions) {
+    comp[u] = componentsFindU(comp, u);
+    comp[v] = componentsFindU(comp, v);
+  }
+}
+
+
+#ifdef _OPENMP
+/**
+ * Update the components of a graph, after a batch of edge insertions (using OpenMP).
+ * Only the forest paths of the batch vertices are touched, so other vertices
+ * may point to an older root; use componentsFind() to obtain their component,
+ * or componentsCompressOmpU() to point every vertex to its root.
+ * @param comp parent of each vertex (union-find forest, updated)
+ * @param insertions edge insertions {u, v, w}
+ */
+template <class K, class V>
+inline void componentsInsertOmpU(vector<K>& comp, const vector<tuple<K, K, V>>& insertions) {
+  size_t I = insertions.size();
+  componentsResizeU(comp, insertions);
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (size_t i=0; i<I; ++i) {
+    const auto& [u, v, w] = insertions[i];
+    componentsLinkOmpU(comp, u, v);
+  }
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (size_t i=0; i<I; ++i) {
+    const auto& [u, v, w] = insertions[i];
+    componentsStore(comp[u], componentsFindOmp(comp, u));
+    componentsStore(comp[v], componentsFindOmp(comp, v));
+  }
+}
+#endif
+#pragma endregion
+#pragma endregion
+} // namespace detail
+} // namespace gve
+
+
+
+
+// Now, we export the public API.
+EXPORT namespace gve {
+  // Methods
+  using detail::componentsFind;
+  using detail::componentsFindU;
+  using detail::componentsLinkU;
+  using detail::componentsCompressU;
+  using detail::componentsSampleFrequent;
+  using detail::components;
+  using detail::componentsInsertU;
+#ifdef _OPENMP
+  using detail::componentsFindOmp;
+  using detail::componentsLinkOmpU;
+  using detail::componentsCompressOmpU;
+  using detail::componentsOmp;
+  using detail::componentsInsertOmpU;
+#endif
+} // namespace gve
@@ -0,0 +1,215 @@
+// Copyright (C) 2025 Subhajit Sahu
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// See LICENSE for full terms
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+#include "_main.hxx"
+#include "Graph.hxx"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+
+
+// An internal namespace helps to hide implementation details.
+// This is particularly useful for pre-C++20 modules.
+namespace gve {
+namespace detail {
+using std::pair;
+using std::vector;
+using std::sort;
+
+
+
+
+#pragma region METHODS
+#pragma region HELPERS
+/**
+ * Obtain the sorted outgoing edges of a vertex [helper function].
+ * @param a sorted outgoing edges (output)
+ * @param x input graph
+ * @param u source vertex id
+ */
+template <class G, class K, class E>
+inline void compressSortedEdgesW(vector<pair<K, E>>& a, const G& x, K u) {
+  a.clear();
+  if (!x.hasVertex(u)) return;
+  x.forEachEdge(u, [&](auto v, auto w) {
+    if constexpr (std::is_empty_v<E>) a.push_back({K(v), E()});
+    else a.push_back({K(v), E(w)});
+  });
+  auto fl = [](const auto& p, const auto& q) { return p.first < q.first; };
+  if (!std::is_sorted(a.begin(), a.end(), fl)) sort(a.begin(), a.end(), fl);
+}
+
+
+/**
+ * Get the number of bytes needed to encode sorted outgoing edges [helper function].
+ * @tparam WEIGHTED are edge weights stored?
+ * @param edges sorted outgoing edges
+ * @returns number of bytes
+ */
+template <bool WEIGHTED, class K, class E>
+inline size_t compressEdgesSize(const vector<pair<K, E>>& edges) {
+  size_t b = 0; K v = K();
+  for (const auto& [t, w] : edges) {
+    b += varintSize(uint64_t(t - v)) + (WEIGHTED? sizeof(E) : 0);
+    v  = t;
+  }
+  return b;
+}
+
+
+/**
+ * Encode sorted outgoing edges as gaps [helper function].
+ * @tparam WEIGHTED are edge weights stored?
+ * @param p output bytes
+ * @param edges sorted outgoing edges
+ * @returns end of written bytes
+ */
+template <bool WEIGHTED, class K, class E>
+inline uint8_t* compressEdgesU(uint8_t *p, const vector<pair<K, E>>& edges) {
+  K v = K();
+  for (const auto& [t, w] : edges) {
+    p = writeVarintU(p, uint64_t(t - v));
+    if constexpr (WEIGHTED) { std::memcpy(p, &w, sizeof(E)); p += sizeof(E); }
+    v = t;
+  }
+  return p;
+}
+
+
+/**
+ * Obtain the vertex value of a vertex, if it exists [helper function].
+ * @tparam V vertex value type
+ * @param x input graph
+ * @param u vertex id
+ * @returns vertex value, or V() if it does not exist or is not stored
+ */
+template <class V, class G, class K>
+inline V compressVertexValue(const G& x, K u) {
+  if constexpr (std::is_empty_v<V>) return V();
+  else return x.hasVertex(u)? V(x.vertexValue(u)) : V();
+}
+#pragma endregion
+
+
+
+
+#pragma region COMPRESS
+/**
+ * Compress a graph into a compressed CSR representation.
+ * @param a output compressed graph (output)
+ * @param x input graph (DiGraphCsr, ArenaDiGraph, ...)
+ */
+template <class K, class V, class E, class O, class G>
+inline void compressGraphW(DiGraphCsrCompressed<K, V, E, O>& a, const G& x) {
+  constexpr bool WEIGHTED = DiGraphCsrCompressed<K, V, E, O>::WEIGHTED;
+  size_t S = x.span();
+  vector<pair<K, E>> edges;
+  a.respan(S);
+  a.data.clear();
+  for (K u=0; u<S; ++u) {
+    compressSortedEdgesW(edges, x, u);
+    size_t b = a.data.size();
+    a.offsets[u] = O(b);
+    a.degrees[u] = K(edges.size());
+    a.values[u]  = compressVertexValue<V>(x, u);
+    a.data.resize(b + compressEdgesSize<WEIGHTED>(edges));
+    compressEdgesU<WEIGHTED>(a.data.data() + b, edges);
+  }
+  a.offsets[S] = O(a.data.size());
+}
+
+
+/**
+ * Compress a graph into a compressed CSR representation.
+ * @param x input graph (DiGraphCsr, ArenaDiGraph, ...)
+ * @returns compressed graph
+ */
+template <class G>
+inline auto compressGraph(const G& x) {
+  using K = typename G::key_type;
+  using V = typename G::vertex_value_type;
+  using E = typename G::edge_value_type;
+  DiGraphCsrCompressed<K, V, E> a;
+  compressGraphW(a, x);
+  return a;
+}
+
+
+#ifdef _OPENMP
+/**
+ * Compress a graph into a compressed CSR representation in parallel.
+ * @param a output compressed graph (output)
+ * @param x input graph (DiGraphCsr, ArenaDiGraph, ...)
+ */
+template <class K, class V, class E, class O, class G>
+inline void compressGraphOmpW(DiGraphCsrCompressed<K, V, E, O>& a, const G& x) {
+  constexpr bool WEIGHTED = DiGraphCsrCompressed<K, V, E, O>::WEIGHTED;
+  size_t S = x.span();
+  int    T = omp_get_max_threads();
+  vector<vector<pair<K, E>>> edges(T);
+  vector<O> buf(T);
+  a.respan(S);
+  // Find the encoded size of each vertex's edges.
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (K u=0; u<S; ++u) {
+    int t = omp_get_thread_num();
+    compressSortedEdgesW(edges[t], x, u);
+    a.offsets[u] = O(compressEdgesSize<WEIGHTED>(edges[t]));
+    a.degrees[u] = K(edges[t].size());
+    a.values[u]  = compressVertexValue<V>(x, u);
+  }
+  // Find the byte offsets, and encode the edges.
+  a.offsets[S] = exclusiveScanOmpW(a.offsets.data(), buf.data(), a.offsets.data(), S);
+  a.data.resize(a.offsets[S]);
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (K u=0; u<S; ++u) {
+    int t = omp_get_thread_num();
+    compressSortedEdgesW(edges[t], x, u);
+    compressEdgesU<WEIGHTED>(a.data.data() + a.offsets[u], edges[t]);
+  }
+}
+
+
+/**
+ * Compress a graph into a compressed CSR representation in parallel.
+ * @param x input graph (DiGraphCsr, ArenaDiGraph, ...)
+ * @returns compressed graph
+ */
+template <class G>
+inline auto compressGraphOmp(const G& x) {
+  using K = typename G::key_type;
+  using V = typename G::vertex_value_type;
+  using E = typename G::edge_value_type;
+  DiGraphCsrCompressed<K, V, E> a;
+  compressGraphOmpW(a, x);
+  return a;
+}
+#endif
+#pragma endregion
+#pragma endregion
+} // namespace detail
+} // namespace gve
+
+
+
+
+// Now, we export the public API.
+EXPORT namespace gve {
+  // Methods
+  using detail::compressGraphW;
+  using detail::compressGraph;
+#ifdef _OPENMP
+  using detail::compressGraphOmpW;
+  using detail::compressGraphOmp;
+#endif
+} // namespace gve
@@ -3,8 +3,16 @@
 // See LICENSE for full terms
 #pragma once
 
+#include <cmath>
+#include <tuple>
+#include <vector>
+#include <algorithm>
 #include "_main.hxx"
+#include "Graph.hxx"
 #include "update.hxx"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 
@@ -13,6 +21,23 @@
 // This is particularly useful for pre-C++20 modules.
 namespace gve {
 namespace detail {
+using std::tuple;
+using std::vector;
+using std::get;
+
+
+
+
+#pragma region CONSTANTS
+#ifndef GVE_CSR_MIN_SLACK
+/** Minimum number of extra edge slots per vertex, when a CSR is built with slack. */
+#define GVE_CSR_MIN_SLACK  2
+#endif
+#pragma endregion
+
+
+
+
 #pragma region METHODS
 #pragma region DUPLICATE IF
 /**
@@ -215,6 +240,179 @@ inline void duplicateArenaOmpW(H& a, const G& x) {
   // printf("duplicateArenaOmpW: Add edges     = %.3f ms\n", duration(t3, t4));
   // printf("duplicateArenaOmpW: Update        = %.3f ms\n", duration(t4, t5));
 }
+
+
+
+#pragma region DUPLICATE CSR
+/**
+ * Get the number of edge slots to reserve for a vertex in CSR [helper function].
+ * @param d degree of vertex
+ * @param slack fraction of extra slots, for future insertions
+ * @returns number of edge slots
+ * @note With nonzero slack, each vertex gets at least GVE_CSR_MIN_SLACK extra
+ * slots, so that the first insertion into a low-degree vertex does not force a rebuild.
+ */
+template <class O>
+inline O duplicateCsrCapacity(size_t d, double slack) {
+  if (slack<=0) return O(d);
+  return O(d + std::max(size_t(std::ceil(slack * d)), size_t(GVE_CSR_MIN_SLACK)));
+}
+
+
+/**
+ * Copy the vertex value and edges of a vertex into its CSR segment [helper function].
+ * @param a output CSR graph (updated)
+ * @param x input graph
+ * @param u vertex id
+ */
+template <class K, class V, class E, class O, class G>
+inline void duplicateCsrVertexW(DiGraphCsr<K, V, E, O>& a, const G& x, K u) {
+  O i = a.offsets[u];
+  if (!x.hasVertex(u)) { a.degrees[u] = K(); return; }
+  if constexpr (!std::is_empty_v<V>) a.values[u] = V(x.vertexValue(u));
+  x.forEachEdge(u, [&](auto v, auto w) {
+    a.edgeKeys[i] = K(v);
+    if constexpr (!std::is_empty_v<E>) a.edgeValues[i] = E(w);
+    ++i;
+  });
+  a.degrees[u] = K(i - a.offsets[u]);
+}
+
+
+/**
+ * Duplicate a graph into CSR format, with slack for future insertions.
+ * @param a output CSR graph (output)
+ * @param x input graph (e.g., ArenaDiGraph)
+ * @param slack fraction of extra edge slots per vertex
+ * @note Each vertex u owns edge slots [offsets[u], offsets[u+1]), of which the
+ * first degrees[u] are in use. Missing vertices are kept as isolated vertices.
+ */
+template <class K, class V, class E, class O, class G>
+inline void duplicateCsrW(DiGraphCsr<K, V, E, O>& a, const G& x, double slack=0) {
+  size_t S = x.span();
+  size_t M = 0;
+  for (size_t u=0; u<S; ++u)
+    M += duplicateCsrCapacity<O>(x.degree(K(u)), slack);
+  a.resize(S, M);
+  // Obtain the offsets of each vertex.
+  for (size_t u=0; u<S; ++u)
+    a.offsets[u] = duplicateCsrCapacity<O>(x.degree(K(u)), slack);
+  a.offsets[S] = O();
+  exclusiveScanW(a.offsets, a.offsets, S+1);
+  // Populate the edges.
+  for (size_t u=0; u<S; ++u)
+    duplicateCsrVertexW(a, x, K(u));
+}
+
+
+/**
+ * Update a CSR duplicate of a graph, after a batch update has been applied.
+ * @param a CSR duplicate of graph before the batch update (updated)
+ * @param x input graph, after the batch update
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param slack fraction of extra edge slots per vertex, if rebuilt
+ * @returns were only the segments of updated vertices rewritten (false if rebuilt)?
+ * @note The CSR is rebuilt only if an updated vertex outgrows its edge slots.
+ */
+template <class K, class V, class E, class O, class G, class W>
+inline bool duplicateCsrUpdateU(DiGraphCsr<K, V, E, O>& a, const G& x, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions, double slack=0) {
+  // Find the vertices whose edges may have changed.
+  vector<K> us;
+  us.reserve(deletions.size() + insertions.size());
+  for (const auto& [u, v, w] : deletions)
+    us.push_back(u);
+  for (const auto& [u, v, w] : insertions)
+    us.push_back(u);
+  std::sort(us.begin(), us.end());
+  us.erase(std::unique(us.begin(), us.end()), us.end());
+  // Rebuild if any of them has run out of slack.
+  bool fits = a.span() == x.span();
+  for (size_t i=0; fits && i<us.size(); ++i) {
+    K u = us[i];
+    fits = x.degree(u) <= size_t(a.offsets[u+1] - a.offsets[u]);
+  }
+  if (!fits) { duplicateCsrW(a, x, slack); return false; }
+  // Rewrite only their segments.
+  for (K u : us)
+    duplicateCsrVertexW(a, x, u);
+  return true;
+}
+
+
+#ifdef _OPENMP
+/**
+ * Duplicate a graph into CSR format, with slack for future insertions [parallel].
+ * @param a output CSR graph (output)
+ * @param x input graph (e.g., ArenaDiGraph)
+ * @param slack fraction of extra edge slots per vertex
+ * @note Each vertex u owns edge slots [offsets[u], offsets[u+1]), of which the
+ * first degrees[u] are in use. Missing vertices are kept as isolated vertices.
+ */
+template <class K, class V, class E, class O, class G>
+inline void duplicateCsrOmpW(DiGraphCsr<K, V, E, O>& a, const G& x, double slack=0) {
+  size_t S = x.span();
+  size_t M = 0;
+  #pragma omp parallel for schedule(static, 2048) reduction(+:M)
+  for (size_t u=0; u<S; ++u)
+    M += duplicateCsrCapacity<O>(x.degree(K(u)), slack);
+  a.resize(S, M);
+  // Obtain the offsets of each vertex.
+  vector<O> buf(omp_get_max_threads());
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t u=0; u<S; ++u)
+    a.offsets[u] = duplicateCsrCapacity<O>(x.degree(K(u)), slack);
+  a.offsets[S] = O();
+  exclusiveScanOmpW(a.offsets, buf.data(), a.offsets, S+1);
+  // Populate the edges.
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (size_t u=0; u<S; ++u)
+    duplicateCsrVertexW(a, x, K(u));
+}
+
+
+/**
+ * Update a CSR duplicate of a graph, after a batch update has been applied [parallel].
+ * @param a CSR duplicate of graph before the batch update (updated)
+ * @param x input graph, after the batch update
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param slack fraction of extra edge slots per vertex, if rebuilt
+ * @returns were only the segments of updated vertices rewritten (false if rebuilt)?
+ * @note The CSR is rebuilt only if an updated vertex outgrows its edge slots.
+ */
+template <class K, class V, class E, class O, class G, class W>
+inline bool duplicateCsrUpdateOmpU(DiGraphCsr<K, V, E, O>& a, const G& x, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions, double slack=0) {
+  size_t DN = deletions.size();
+  size_t IN = insertions.size();
+  // Find the vertices whose edges may have changed.
+  vector<K> us(DN + IN);
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t i=0; i<DN; ++i)
+    us[i] = get<0>(deletions[i]);
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t i=0; i<IN; ++i)
+    us[DN+i] = get<0>(insertions[i]);
+  sortValuesOmpU(us, [](K u, K v) { return u < v; });
+  us.erase(std::unique(us.begin(), us.end()), us.end());
+  // Rebuild if any of them has run out of slack.
+  bool fits = a.span() == x.span();
+  if (fits) {
+    #pragma omp parallel for schedule(static, 2048) reduction(&&:fits)
+    for (size_t i=0; i<us.size(); ++i) {
+      K u = us[i];
+      fits = fits && x.degree(u) <= size_t(a.offsets[u+1] - a.offsets[u]);
+    }
+  }
+  if (!fits) { duplicateCsrOmpW(a, x, slack); return false; }
+  // Rewrite only their segments.
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (size_t i=0; i<us.size(); ++i)
+    duplicateCsrVertexW(a, x, us[i]);
+  return true;
+}
+#endif
+#pragma endregion
 #pragma endregion
 } // namespace detail
 } // namespace gve
@@ -229,11 +427,15 @@ EXPORT namespace gve {
   using detail::duplicateIf;
   using detail::duplicateW;
   using detail::duplicate;
+  using detail::duplicateCsrW;
+  using detail::duplicateCsrUpdateU;
 #ifdef _OPENMP
   using detail::duplicateIfOmpW;
   using detail::duplicateIfOmp;
   using detail::duplicateOmpW;
   using detail::duplicateOmp;
   using detail::duplicateArenaOmpW;
+  using detail::duplicateCsrOmpW;
+  using detail::duplicateCsrUpdateOmpU;
 #endif
 } // namespace gve
@@ -26,11 +26,22 @@ namespace detail {
 using std::string;
 using std::string_view;
 using std::vector;
+using std::unique_ptr;
 using std::min;
 
 
 
 
+#pragma region CONSTANTS
+#ifndef GVE_READ_BUDGET
+/** Default memory budget for buffering edges, when reading a graph in two passes [bytes]. */
+#define GVE_READ_BUDGET  (size_t(256) << 20)
+#endif
+#pragma endregion
+
+
+
+
 #pragma region READ FROM STRING
 #pragma region READ COO FORMAT HEADER
 /**
@@ -151,7 +162,9 @@ inline void readEdgelistFormatDoUnchecked(string_view data, bool symmetric, FB f
   while (true) {
     // Read u, v, w (if weighted).
     uint64_t u = 0, v = 0; double w = 1;
-    it = findNextDigit(it, ie);
+    // Skip past comments.
+    while (it!=ie && !isDigit(*it))
+      it = *it=='%' || *it=='#'? findNextLine(it, ie) : it+1;
     if (it==ie) break;  // No more lines
     it = parseWholeNumberW(u, it, ie);  // Source vertex
     it = findNextDigit(it, ie);
@@ -278,6 +291,105 @@ inline vector<size_t> readEdgelistFormatToListsOmpU(IIK degrees, IIK sources, II
   if (CHECK && !err.empty()) throw err;
   return is;
 }
+
+
+/**
+ * Read EdgeList format data in two passes, first to count the edges, and then to place them.
+ * @tparam WEIGHTED is graph weighted?
+ * @tparam BASE base vertex id (0 or 1)
+ * @tparam CHECK check for error?
+ * @tparam K vertex key type (for buffered edges)
+ * @tparam E edge value type (for buffered edges)
+ * @param data input data
+ * @param symmetric is graph symmetric?
+ * @param size expected number of edges (upper bound)
+ * @param budget memory budget for buffered edges [bytes]
+ * @param fc on counting an edge (u, v, w)
+ * @param fp on preparing for placing the edges (number of edges)
+ * @param fb on placing an edge (u, v, w)
+ * @returns number of edges read
+ * @note Edges of blocks that fit within the budget are buffered in the first pass, and
+ * the remaining blocks are parsed again in the second pass. Peak extra memory is thus
+ * bounded by the budget, irrespective of the number of threads.
+ */
+template <bool WEIGHTED=false, int BASE=1, bool CHECK=false, class K=uint32_t, class E=float, class FC, class FP, class FB>
+inline size_t readEdgelistFormatDoTwoPassOmp(string_view data, bool symmetric, size_t size, size_t budget, FC fc, FP fp, FB fb) {
+  const size_t DATA  = data.size();
+  const size_t BLOCK = 256 * 1024;  // Characters per block (256KB)
+  const size_t CHUNK = 4096;        // Edges per buffer chunk
+  const size_t EDGE  = 2 * sizeof(K) + (WEIGHTED? sizeof(E) : 0);
+  const size_t B = ceilDiv(DATA, BLOCK);
+  const size_t C = min(budget / (CHUNK * EDGE), ceilDiv(size, CHUNK) + B);
+  // Allocate buffer chunks, and note which block each belongs to.
+  unique_ptr<K[]> bsources(new K[C * CHUNK]);
+  unique_ptr<K[]> btargets(new K[C * CHUNK]);
+  unique_ptr<E[]> bweights(WEIGHTED? new E[C * CHUNK] : nullptr);
+  vector<size_t> chunkBlock(C), chunkSize(C);
+  vector<char>   blockBuffered(B);
+  FormatError err;     // Common error
+  size_t chunks = 0;   // Number of chunks reserved
+  size_t M = 0;        // Number of edges read
+  // Count (and buffer) edges of each block in parallel.
+  #pragma omp parallel shared(err) reduction(+:M)
+  {
+    #pragma omp for schedule(dynamic) nowait
+    for (size_t b=0; b<B; ++b) {
+      if (CHECK && !err.empty()) continue;
+      string_view bdata = readEdgelistFormatBlock(data, b*BLOCK, BLOCK);
+      bool   buffered = true;
+      size_t c = C, i = CHUNK;  // Current chunk, and index within it
+      auto fd = [&](auto u, auto v, auto w) {
+        fc(u, v, w);
+        ++M;
+        if (!buffered) return;
+        // Reserve a new chunk, if the current one is full.
+        if (i==CHUNK) {
+          if (c<C) chunkSize[c] = i;
+          #pragma omp atomic capture
+          c = chunks++;
+          if (c>=C) { buffered = false; return; }
+          chunkBlock[c] = b;
+          i = 0;
+        }
+        size_t j = c*CHUNK + i++;
+        bsources[j] = K(u);
+        btargets[j] = K(v);
+        if constexpr (WEIGHTED) bweights[j] = E(w);
+      };
+      if constexpr (CHECK) {
+        try { readEdgelistFormatDo<WEIGHTED, BASE, true>(bdata, symmetric, fd); }
+        catch (const FormatError& e) {
+          #pragma omp critical
+          if (err.empty()) err = e;
+        }
+      }
+      else readEdgelistFormatDo<WEIGHTED, BASE>(bdata, symmetric, fd);
+      if (buffered && c<C) chunkSize[c] = i;
+      blockBuffered[b] = buffered;
+    }
+  }
+  // Throw error if any.
+  if (CHECK && !err.empty()) throw err;
+  fp(M);
+  // Place buffered edges, and parse the remaining blocks again.
+  size_t CB = min(chunks, C);
+  #pragma omp parallel
+  {
+    #pragma omp for schedule(dynamic) nowait
+    for (size_t c=0; c<CB; ++c) {
+      if (!blockBuffered[chunkBlock[c]]) continue;
+      for (size_t j=c*CHUNK, J=j+chunkSize[c]; j<J; ++j)
+        fb(bsources[j], btargets[j], WEIGHTED? bweights[j] : E(1));
+    }
+    #pragma omp for schedule(dynamic) nowait
+    for (size_t b=0; b<B; ++b) {
+      if (blockBuffered[b]) continue;
+      string_view bdata = readEdgelistFormatBlock(data, b*BLOCK, BLOCK);
+      readEdgelistFormatDo<WEIGHTED, BASE, CHECK>(bdata, symmetric, fb);
+    }
+  }
+  return M;
+}
 #endif
 #pragma endregion
 
@@ -316,6 +428,7 @@ inline size_t convertEdgelistToCsrListsW(IO offsets, IK edgeKeys, IE edgeValues,
 }
 
 
+#ifdef _OPENMP
 /**
  * Convert Edgelist to CSR (lists).
  * @tparam WEIGHTED is graph weighted?
@@ -410,6 +523,7 @@ inline size_t convertEdgelistToCsrListsOmpW(IIO offsets, IIK edgeKeys, IIE edgeV
   }
   return M;
 }
+#endif
 #pragma endregion
 
 
@@ -457,6 +571,7 @@ inline void readMtxFormatToCsrW(G& a, string_view data) {
 }
 
 
+#ifdef _OPENMP
 /**
  * Read data in MTX format, and convert to CSR.
  * @tparam WEIGHTED is graph weighted?
@@ -526,6 +641,56 @@ inline void readMtxFormatToCsrOmpW(G& a, string_view data) {
     if (WEIGHTED) delete edgeValues[i];
   }
 }
+
+
+/**
+ * Read data in MTX format, and convert to CSR, within a memory budget.
+ * @tparam WEIGHTED is graph weighted?
+ * @tparam BASE base vertex id (0 or 1)
+ * @tparam CHECK check for error?
+ * @param a output csr graph (updated)
+ * @param data input data
+ * @param budget memory budget for buffered edges [bytes]
+ * @note Apart from the budget, only the vertex degrees are needed as extra memory.
+ */
+template <bool WEIGHTED=false, int BASE=1, bool CHECK=false, class G>
+inline void readMtxFormatToCsrStreamingOmpW(G& a, string_view data, size_t budget=GVE_READ_BUDGET) {
+  using O = typename G::offset_type;
+  using K = typename G::key_type;
+  using E = typename G::edge_value_type;
+  // Read MTX format header.
+  bool symmetric; size_t rows, cols, size;
+  size_t head = readMtxFormatHeaderW(symmetric, rows, cols, size, data);
+  data.remove_prefix(head);
+  const int    T = omp_get_max_threads();
+  const size_t N = max(rows, cols);
+  const size_t M = symmetric? 2 * size : size;
+  vector<size_t> buf(T);
+  // Count vertex degrees, before the CSR is allocated.
+  unique_ptr<K[]> degrees(new K[N]);
+  fillValueOmpU(degrees.get(), N, K());
+  auto fc = [&](auto u, auto v, auto w) {
+    #pragma omp atomic
+    ++degrees[u];
+  };
+  // Allocate CSR of the exact size, and compute shifted offsets.
+  auto fp = [&](size_t MA) {
+    a.resize(N, MA);
+    copyValuesOmpW(a.degrees, degrees.get(), N);
+    a.offsets[0] = O();
+    exclusiveScanOmpW(a.offsets+1, buf.data(), a.degrees, N);
+  };
+  // Place edges at the shifted offsets, which become the final offsets.
+  auto fb = [&](auto u, auto v, auto w) {
+    O j = O();
+    #pragma omp atomic capture
+    j = a.offsets[u+1]++;
+    a.edgeKeys[j] = K(v);
+    if constexpr (WEIGHTED) a.edgeValues[j] = E(w);
+  };
+  readEdgelistFormatDoTwoPassOmp<WEIGHTED, BASE, CHECK, K, E>(data, symmetric, M, budget, fc, fp, fb);
+}
+#endif
 #pragma endregion
 
 
@@ -565,6 +730,7 @@ inline size_t convertEdgelistToGraphW(G& a, IK degrees, IK sources, IK targets,
 }
 
 
+#ifdef _OPENMP
 /**
  * Convert Edgelist to Graph (Arena-allocator based).
  * @tparam WEIGHTED is graph weighted?
@@ -648,6 +814,7 @@ inline size_t convertEdgelistToGraphOmpW(G &a, IIO offsets, IIK edgeKeys, IIE ed
   a.updateOmp(true, false);
   return M;
 }
+#endif
 #pragma endregion
 
 
@@ -689,6 +856,7 @@ inline void readMtxFormatToGraphW(G& a, string_view data) {
 }
 
 
+#ifdef _OPENMP
 /**
  * Read data in MTX format, and convert to Graph (Arena-allocator based).
  * @tparam WEIGHTED is graph weighted?
@@ -750,6 +918,51 @@ inline void readMtxFormatToGraphOmpW(G& a, string_view data) {
     if (WEIGHTED) delete edgeValues[i];
   }
 }
+
+
+/**
+ * Read data in MTX format, and convert to Graph (Arena-allocator based), within a memory budget.
+ * @tparam WEIGHTED is graph weighted?
+ * @tparam BASE base vertex id (0 or 1)
+ * @tparam CHECK check for error?
+ * @param a output graph (updated)
+ * @param data input data
+ * @param budget memory budget for buffered edges [bytes]
+ * @note Apart from the budget, only the vertex degrees are needed as extra memory.
+ */
+template <bool WEIGHTED=false, int BASE=1, bool CHECK=false, class G>
+inline void readMtxFormatToGraphStreamingOmpW(G& a, string_view data, size_t budget=GVE_READ_BUDGET) {
+  using K = typename G::key_type;
+  using E = typename G::edge_value_type;
+  // Read MTX format header.
+  bool symmetric; size_t rows, cols, size;
+  size_t head = readMtxFormatHeaderW(symmetric, rows, cols, size, data);
+  data.remove_prefix(head);
+  const size_t N = max(rows, cols);
+  const size_t M = symmetric? 2 * size : size;
+  // Count vertex degrees.
+  unique_ptr<K[]> degrees(new K[N]);
+  fillValueOmpU(degrees.get(), N, K());
+  auto fc = [&](auto u, auto v, auto w) {
+    #pragma omp atomic
+    ++degrees[u];
+  };
+  // Add vertices, and allocate space for their edges.
+  auto fp = [&](size_t MA) {
+    a.clearOmp();
+    a.reserveOmp(N);
+    #pragma omp parallel for schedule(static, 2048)
+    for (size_t u=0; u<N; ++u)
+      a.addVertex(u);
+    #pragma omp parallel for schedule(dynamic, 2048)
+    for (size_t u=0; u<N; ++u)
+      a.allocateEdges(u, degrees[u]);
+  };
+  auto fb = [&](auto u, auto v, auto w) { a.addEdgeUnsafeOmp(K(u), K(v), WEIGHTED? E(w) : E(1)); };
+  readEdgelistFormatDoTwoPassOmp<WEIGHTED, BASE, CHECK, K, E>(data, symmetric, M, budget, fc, fp, fb);
+  a.updateOmp(true, false);
+}
+#endif
 #pragma endregion
 #pragma endregion
 } // namespace detail
@@ -773,9 +986,12 @@ EXPORT namespace gve {
   using detail::readMtxFormatToGraphW;
 #ifdef _OPENMP
   using detail::readEdgelistFormatToListsOmpU;
+  using detail::readEdgelistFormatDoTwoPassOmp;
   using detail::convertEdgelistToCsrListsOmpW;
   using detail::readMtxFormatToCsrOmpW;
+  using detail::readMtxFormatToCsrStreamingOmpW;
   using detail::convertEdgelistToGraphOmpW;
   using detail::readMtxFormatToGraphOmpW;
+  using detail::readMtxFormatToGraphStreamingOmpW;
 #endif
 } // namespace gve
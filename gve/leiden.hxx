@@ -115,6 +115,8 @@ struct LeidenResult {
   float aggregationTime;
   /** Number of vertices initially marked as affected. */
   size_t affectedVertices;
+  /** Statistics of each pass and iteration (recorded only with GVE_PROFILE). */
+  ProfileLog profile;
   #pragma endregion
 
 
@@ -172,12 +174,12 @@ struct LeidenResult {
  * @param vcout total edge weight from vertex u to community C (updated)
  * @param S size of each hashtable
  */
-template <class K, class W>
-inline void leidenAllocateHashtablesW(vector<vector<K>*>& vcs, vector<vector<W>*>& vcout, size_t S) {
+template <class K, class A>
+inline void leidenAllocateHashtablesW(vector<vector<K>*>& vcs, vector<A*>& vcout, size_t S) {
   size_t N = vcs.size();
   for (size_t i=0; i<N; ++i) {
     vcs[i]   = new vector<K>();
-    vcout[i] = new vector<W>(S);
+    vcout[i] = new A(S);
   }
 }
 
@@ -187,8 +189,8 @@ inline void leidenAllocateHashtablesW(vector<vector<K>*>& vcs, vector<vector<W>*
  * @param vcs communities vertex u is linked to (updated)
  * @param vcout total edge weight from vertex u to community C (updated)
  */
-template <class K, class W>
-inline void leidenFreeHashtablesW(vector<vector<K>*>& vcs, vector<vector<W>*>& vcout) {
+template <class K, class A>
+inline void leidenFreeHashtablesW(vector<vector<K>*>& vcs, vector<A*>& vcout) {
   size_t N = vcs.size();
   for (size_t i=0; i<N; ++i) {
     delete vcs[i];
@@ -419,13 +421,14 @@ inline void leidenUpdateWeightsFromOmpU(vector<W>& vtot, vector<W>& ctot, const
  * @param vcom community each vertex belongs to
  * @param vcob community bound each vertex belongs to
  */
-template <bool SELF=false, bool REFINE=false, class K, class V, class W>
-inline void leidenScanCommunityW(vector<K>& vcs, vector<W>& vcout, K u, K v, V w, const vector<K>& vcom, const vector<K>& vcob) {
+template <bool SELF=false, bool REFINE=false, class K, class V, class A>
+inline void leidenScanCommunityW(vector<K>& vcs, A& vcout, K u, K v, V w, const vector<K>& vcom, const vector<K>& vcob) {
   if (!SELF && u==v) return;
   if (REFINE && vcob[u]!=vcob[v]) return;
   K c = vcom[v];
-  if (!vcout[c]) vcs.push_back(c);
-  vcout[c] += w;
+  auto& a = vcout[c];
+  if (!a) vcs.push_back(c);
+  a += w;
 }
 
 
@@ -438,8 +441,8 @@ inline void leidenScanCommunityW(vector<K>& vcs, vector<W>& vcout, K u, K v, V w
  * @param w outgoing edge weight
  * @param vcom community each vertex belongs to
  */
-template <bool SELF=false, class K, class V, class W>
-inline void leidenScanCommunityW(vector<K>& vcs, vector<W>& vcout, K u, K v, V w, const vector<K>& vcom) {
+template <bool SELF=false, class K, class V, class A>
+inline void leidenScanCommunityW(vector<K>& vcs, A& vcout, K u, K v, V w, const vector<K>& vcom) {
   leidenScanCommunityW<SELF, false>(vcs, vcout, u, v, w, vcom, vcom);
 }
 
@@ -453,8 +456,8 @@ inline void leidenScanCommunityW(vector<K>& vcs, vector<W>& vcout, K u, K v, V w
  * @param vcom community each vertex belongs to
  * @param vcob community bound each vertex belongs to
  */
-template <bool SELF=false, bool REFINE=false, class G, class K, class W>
-inline void leidenScanCommunitiesW(vector<K>& vcs, vector<W>& vcout, const G& x, K u, const vector<K>& vcom, const vector<K>& vcob) {
+template <bool SELF=false, bool REFINE=false, class G, class K, class A>
+inline void leidenScanCommunitiesW(vector<K>& vcs, A& vcout, const G& x, K u, const vector<K>& vcom, const vector<K>& vcob) {
   x.forEachEdge(u, [&](auto v, auto w) { leidenScanCommunityW<SELF, REFINE>(vcs, vcout, u, v, w, vcom, vcob); });
 }
 
@@ -467,8 +470,8 @@ inline void leidenScanCommunitiesW(vector<K>& vcs, vector<W>& vcout, const G& x,
  * @param u given vertex
  * @param vcom community each vertex belongs to
  */
-template <bool SELF=false, class G, class K, class W>
-inline void leidenScanCommunitiesW(vector<K>& vcs, vector<W>& vcout, const G& x, K u, const vector<K>& vcom) {
+template <bool SELF=false, class G, class K, class A>
+inline void leidenScanCommunitiesW(vector<K>& vcs, A& vcout, const G& x, K u, const vector<K>& vcom) {
   leidenScanCommunitiesW<SELF, false>(vcs, vcout, x, u, vcom, vcom);
 }
 
@@ -486,6 +489,18 @@ inline void leidenClearScanW(vector<K>& vcs, vector<W>& vcout) {
 }
 
 
+/**
+ * Clear communities scan data, in a scan accumulator.
+ * @param vcs communities vertex u is linked to (updated)
+ * @param vcout total edge weight from vertex u to community C (updated)
+ */
+template <class K, class W>
+inline void leidenClearScanW(vector<K>& vcs, ScanAccumulator<K, W>& vcout) {
+  vcout.clear();
+  vcs.clear();
+}
+
+
 /**
  * Choose connected community with best delta modularity.
  * @param x original graph
@@ -499,13 +514,13 @@ inline void leidenClearScanW(vector<K>& vcs, vector<W>& vcout) {
  * @param R resolution (0, 1]
  * @returns [best community, delta modularity]
  */
-template <bool SELF=false, class G, class K, class W>
-inline auto leidenChooseCommunity(const G& x, K u, const vector<K>& vcom, const vector<W>& vtot, const vector<W>& ctot, const vector<K>& vcs, const vector<W>& vcout, double M, double R) {
+template <bool SELF=false, class G, class K, class W, class A>
+inline auto leidenChooseCommunity(const G& x, K u, const vector<K>& vcom, const vector<W>& vtot, const vector<W>& ctot, const vector<K>& vcs, const A& vcout, double M, double R) {
   K cmax = K(), d = vcom[u];
-  W emax = W();
+  W emax = W(), vdout = vcout[d];
   for (K c : vcs) {
     if (!SELF && c==d) continue;
-    W e = deltaModularity(vcout[c], vcout[d], vtot[u], ctot[c], ctot[d], M, R);
+    W e = deltaModularity(vcout[c], vdout, vtot[u], ctot[c], ctot[d], M, R);
     if (e>emax) { emax = e; cmax = c; }
   }
   return std::make_pair(cmax, emax);
@@ -589,8 +604,8 @@ inline bool leidenChangeCommunityOmpW(vector<K>& vcom, vector<W>& ctot, const G&
  * @param fa is vertex allowed to be updated?
  * @returns iterations performed (0 if converged already)
  */
-template <bool REFINE=false, class G, class K, class W, class B, class FC, class FA>
-inline int leidenMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<K>& vcs, vector<W>& vcout, const G& x, const vector<K>& vcob, const vector<W>& vtot, double M, double R, int L, FC fc, FA fa) {
+template <bool REFINE=false, class G, class K, class W, class B, class FC, class FA, class A>
+inline int leidenMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<K>& vcs, A& vcout, const G& x, const vector<K>& vcob, const vector<W>& vtot, double M, double R, int L, FC fc, FA fa) {
   int l = 0;
   W  el = W();
   for (; l<L;) {
@@ -627,8 +642,8 @@ inline int leidenMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector
  * @param fc has local moving phase converged?
  * @returns iterations performed (0 if converged already)
  */
-template <bool REFINE=false, class G, class K, class W, class B, class FC>
-inline int leidenMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<K>& vcs, vector<W>& vcout, const G& x, const vector<K>& vcob, const vector<W>& vtot, double M, double R, int L, FC fc) {
+template <bool REFINE=false, class G, class K, class W, class B, class FC, class A>
+inline int leidenMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<K>& vcs, A& vcout, const G& x, const vector<K>& vcob, const vector<W>& vtot, double M, double R, int L, FC fc) {
   auto fa = [](auto u) { return true; };
   return leidenMoveW<REFINE>(vcom, ctot, vaff, vcs, vcout, x, vcob, vtot, M, R, L, fc, fa);
 }
@@ -650,28 +665,40 @@ inline int leidenMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector
  * @param L max iterations
  * @param fc has local moving phase converged?
  * @param fa is vertex allowed to be updated?
+ * @param pl profile log (optional)
  * @returns iterations performed (0 if converged already)
  */
-template <bool REFINE=false, class G, class K, class W, class B, class FC, class FA>
-inline int leidenMoveOmpW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<vector<K>*>& vcs, vector<vector<W>*>& vcout, const G& x, const vector<K>& vcob, const vector<W>& vtot, double M, double R, int L, FC fc, FA fa) {
+template <bool REFINE=false, class G, class K, class W, class B, class FC, class FA, class A>
+inline int leidenMoveOmpW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<vector<K>*>& vcs, vector<A*>& vcout, const G& x, const vector<K>& vcob, const vector<W>& vtot, double M, double R, int L, FC fc, FA fa, ProfileLog *pl=nullptr) {
   size_t S = x.span();
   int l = 0;
   W  el = W();
   for (; l<L;) {
     el = W();
-    #pragma omp parallel for schedule(dynamic, 2048) reduction(+:el)
-    for (K u=0; u<S; ++u) {
+    GVE_PROFILE_DO(auto t0 = timeNow());
+    #pragma omp parallel reduction(+:el)
+    {
       int t = omp_get_thread_num();
-      if (!x.hasVertex(u)) continue;
-      if (!fa(u) || !vaff[u]) continue;
-      if (REFINE && ctot[vcom[u]]>vtot[u]) continue;
-      leidenClearScanW(*vcs[t], *vcout[t]);
-      leidenScanCommunitiesW<false, REFINE>(*vcs[t], *vcout[t], x, u, vcom, vcob);
-      auto [c, e] = leidenChooseCommunity(x, u, vcom, vtot, ctot, *vcs[t], *vcout[t], M, R);
-      if (c && leidenChangeCommunityOmpW<REFINE>(vcom, ctot, x, u, c, vtot)) x.forEachEdgeKey(u, [&](auto v) { vaff[v] = B(1); });
-      vaff[u] = B();
-      el += e;  // l1-norm
+      GVE_PROFILE_DO(auto t1 = timeNow(); size_t na = 0, nc = 0, ne = 0);
+      #pragma omp for schedule(dynamic, 2048) nowait
+      for (K u=0; u<S; ++u) {
+        if (!x.hasVertex(u)) continue;
+        if (!fa(u) || !vaff[u]) continue;
+        if (REFINE && ctot[vcom[u]]>vtot[u]) continue;
+        leidenClearScanW(*vcs[t], *vcout[t]);
+        leidenScanCommunitiesW<false, REFINE>(*vcs[t], *vcout[t], x, u, vcom, vcob);
+        auto [c, e] = leidenChooseCommunity(x, u, vcom, vtot, ctot, *vcs[t], *vcout[t], M, R);
+        if (c && leidenChangeCommunityOmpW<REFINE>(vcom, ctot, x, u, c, vtot)) {
+          x.forEachEdgeKey(u, [&](auto v) { vaff[v] = B(1); });
+          GVE_PROFILE_DO(++nc);
+        }
+        vaff[u] = B();
+        el += e;  // l1-norm
+        GVE_PROFILE_DO(++na; ne += x.degree(u));
+      }
+      GVE_PROFILE_DO(if (pl) pl->countU(t, na, nc, ne, duration(t1)));
     }
+    GVE_PROFILE_DO(if (pl) pl->recordThreads(REFINE? "refine" : "move", l, duration(t0)));
     if (REFINE || fc(el, l++)) break;
   }
   return l>1 || el? l : 0;
@@ -692,12 +719,13 @@ inline int leidenMoveOmpW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vec
  * @param R resolution (0, 1]
  * @param L max iterations
  * @param fc has local moving phase converged?
+ * @param pl profile log (optional)
  * @returns iterations performed (0 if converged already)
  */
-template <bool REFINE=false, class G, class K, class W, class B, class FC>
-inline int leidenMoveOmpW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<vector<K>*>& vcs, vector<vector<W>*>& vcout, const G& x, const vector<K>& vcob, const vector<W>& vtot, double M, double R, int L, FC fc) {
+template <bool REFINE=false, class G, class K, class W, class B, class FC, class A>
+inline int leidenMoveOmpW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<vector<K>*>& vcs, vector<A*>& vcout, const G& x, const vector<K>& vcob, const vector<W>& vtot, double M, double R, int L, FC fc, ProfileLog *pl=nullptr) {
   auto fa = [](auto u) { return true; };
-  return leidenMoveOmpW<REFINE>(vcom, ctot, vaff, vcs, vcout, x, vcob, vtot, M, R, L, fc, fa);
+  return leidenMoveOmpW<REFINE>(vcom, ctot, vaff, vcs, vcout, x, vcob, vtot, M, R, L, fc, fa, pl);
 }
 #endif
 #pragma endregion
@@ -932,8 +960,8 @@ inline void leidenLookupCommunitiesOmpU(vector<K>& a, const vector<K>& vcom) {
  * @param cedg vertices belonging to each community
  * @param yoff offsets for vertices belonging to each community
  */
-template <class G, class K, class W>
-inline void leidenAggregateEdgesW(vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<K>& vcs, vector<W>& vcout, const G& x, const vector<K>& vcom, const vector<K>& coff, const vector<K>& cedg, const vector<size_t>& yoff) {
+template <class G, class K, class W, class A>
+inline void leidenAggregateEdgesW(vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<K>& vcs, A& vcout, const G& x, const vector<K>& vcom, const vector<K>& coff, const vector<K>& cedg, const vector<size_t>& yoff) {
   size_t C = coff.size() - 1;
   fillValueU(ydeg, K());
   for (K c=0; c<C; ++c) {
@@ -963,8 +991,8 @@ inline void leidenAggregateEdgesW(vector<K>& ydeg, vector<K>& yedg, vector<W>& y
  * @param cedg vertices belonging to each community
  * @param yoff offsets for vertices belonging to each community
  */
-template <class G, class K, class W>
-inline void leidenAggregateEdgesOmpW(vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<vector<K>*>& vcs, vector<vector<W>*>& vcout, const G& x, const vector<K>& vcom, const vector<K>& coff, const vector<K>& cedg, const vector<size_t>& yoff) {
+template <class G, class K, class W, class A>
+inline void leidenAggregateEdgesOmpW(vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<vector<K>*>& vcs, vector<A*>& vcout, const G& x, const vector<K>& vcom, const vector<K>& coff, const vector<K>& cedg, const vector<size_t>& yoff) {
   size_t C = coff.size() - 1;
   fillValueOmpU(ydeg, K());
   #pragma omp parallel for schedule(dynamic, 2048)
@@ -1029,8 +1057,8 @@ inline size_t leidenRenumberCommunitiesOmpW(vector<K>& vcom, vector<K>& cext, ve
  * @param coff offsets for vertices belonging to each community
  * @param cedg vertices belonging to each community
  */
-template <class G, class K, class W>
-inline void leidenAggregateW(vector<size_t>& yoff, vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<K>& vcs, vector<W>& vcout, const G& x, const vector<K>& vcom, vector<K>& coff, vector<K>& cedg) {
+template <class G, class K, class W, class A>
+inline void leidenAggregateW(vector<size_t>& yoff, vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<K>& vcs, A& vcout, const G& x, const vector<K>& vcom, vector<K>& coff, vector<K>& cedg) {
   size_t C = coff.size() - 1;
   leidenCommunityTotalDegreeW(yoff, x, vcom);
   yoff[C] = exclusiveScanW(yoff.data(), yoff.data(), C);
@@ -1053,8 +1081,8 @@ inline void leidenAggregateW(vector<size_t>& yoff, vector<K>& ydeg, vector<K>& y
  * @param coff offsets for vertices belonging to each community
  * @param cedg vertices belonging to each community
  */
-template <class G, class K, class W>
-inline void leidenAggregateOmpW(vector<size_t>& yoff, vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<size_t>& bufs, vector<vector<K>*>& vcs, vector<vector<W>*>& vcout, const G& x, const vector<K>& vcom, vector<K>& coff, vector<K>& cedg) {
+template <class G, class K, class W, class A>
+inline void leidenAggregateOmpW(vector<size_t>& yoff, vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<size_t>& bufs, vector<vector<K>*>& vcs, vector<A*>& vcout, const G& x, const vector<K>& vcom, vector<K>& coff, vector<K>& cedg) {
   size_t C = coff.size() - 1;
   leidenCommunityTotalDegreeOmpW(yoff, x, vcom);
   yoff[C] = exclusiveScanOmpW(yoff.data(), bufs.data(), yoff.data(), C);
@@ -1151,7 +1179,9 @@ inline auto leidenInvoke(const G& x, const LeidenOptions& o, FI fi, FM fm, FA fa
           else         m += leidenMoveW<true>(vcom, ctot, vaff, vcs, vcout, y, vcob, vtot, M, R, L, fc);
         });
         l += max(m, 1); ++p;
-        if (m<=1 || p>=P) break;
+        // Dynamic runs start from a converged membership, so local-moving may not move any vertex
+        // in the first pass. Its refined (connected) communities must still be aggregated.
+        if ((m<=1 && !(DYNAMIC && isFirst)) || p>=P) break;
         size_t GN = isFirst? x.order() : y.order();
         size_t CN = 0;
         if (isFirst) CN = leidenCommunityExistsW(cv.degrees, x, ucom);
@@ -1221,7 +1251,7 @@ inline auto leidenInvokeOmp(const G& x, const LeidenOptions& o, FI fi, FM fm, FA
   vector<K> bufk(T);        // Buffer for exclusive scan
   vector<size_t> bufs(T);   // Buffer for exclusive scan
   vector<vector<K>*> vcs(T);    // Hashtable keys
-  vector<vector<W>*> vcout(T);  // Hashtable values
+  vector<ScanAccumulator<K, W>*> vcout(T);  // Hashtable values
   if (!DYNAMIC) ucom.resize(S);
   if (!DYNAMIC) utot.resize(S);
   if (!DYNAMIC) ctot.resize(S);
@@ -1231,6 +1261,7 @@ inline auto leidenInvokeOmp(const G& x, const LeidenOptions& o, FI fi, FM fm, FA
   DiGraphCsrVector<K, None, None, K> cv(S, S);  // CSR for community vertices
   DiGraphCsrVector<K, None, W> y(S, Y);         // CSR for aggregated graph (input);  y(S, X)
   DiGraphCsrVector<K, None, W> z(S, Z);         // CSR for aggregated graph (output); z(S, X)
+  ProfileLog pl;  // Statistics of each pass and iteration
   // Perform Leiden algorithm.
   float tm = 0, ti = 0, tp = 0, tl = 0, tr = 0, ta = 0;  // Time spent in different phases
   float t  = measureDurationMarked([&](auto mark) {
@@ -1244,6 +1275,7 @@ inline auto leidenInvokeOmp(const G& x, const LeidenOptions& o, FI fi, FM fm, FA
     fillValueOmpU(utot, W());
     fillValueOmpU(vtot, W());
     fillValueOmpU(ctot, W());
+    GVE_PROFILE_DO(pl.clear());
     cv.respan(S);
     y .respan(S);
     z .respan(S);
@@ -1252,7 +1284,8 @@ inline auto leidenInvokeOmp(const G& x, const LeidenOptions& o, FI fi, FM fm, FA
       // Initialize community membership and total vertex/community weights.
       ti += measureDuration([&]() { fi(ucom, utot, ctot); });
       // Mark affected vertices.
-      tm += measureDuration([&]() { fm(vaff, vcs, vcout, ucom, utot, ctot); });
+      float dm = measureDuration([&]() { fm(vaff, vcs, vcout, ucom, utot, ctot); }); tm += dm;
+      GVE_PROFILE_DO(pl.record("mark", -1, dm, x.order(), X); pl.records.back().affected = countValueOmp(vaff, B(1)));
       // Start timing first pass.
       auto t0 = timeNow(), t1 = t0;
       // Start local-moving, refinement, aggregation phases.
@@ -1262,22 +1295,28 @@ inline auto leidenInvokeOmp(const G& x, const LeidenOptions& o, FI fi, FM fm, FA
         if (p==1) t1 = timeNow();
         bool isFirst = p==0;
         int m = 0;
-        tl += measureDuration([&]() {
-          if (isFirst) m += leidenMoveOmpW(ucom, ctot, vaff, vcs, vcout, x, vcob, utot, M, R, L, fc, fa);
-          else         m += leidenMoveOmpW(vcom, ctot, vaff, vcs, vcout, y, vcob, vtot, M, R, L, fc);
-        });
-        tr += measureDuration([&]() {
+        GVE_PROFILE_DO(pl.pass = p);
+        float dl = measureDuration([&]() {
+          if (isFirst) m += leidenMoveOmpW(ucom, ctot, vaff, vcs, vcout, x, vcob, utot, M, R, L, fc, fa, &pl);
+          else         m += leidenMoveOmpW(vcom, ctot, vaff, vcs, vcout, y, vcob, vtot, M, R, L, fc, &pl);
+        }); tl += dl;
+        GVE_PROFILE_DO(pl.record("move", -1, dl, isFirst? x.order() : y.order(), isFirst? X : y.size()));
+        float dr = measureDuration([&]() {
           if (isFirst) copyValuesOmpW(vcob, ucom);
           else         copyValuesOmpW(vcob, vcom);
           if (isFirst) leidenInitializeOmpW(ucom, ctot, x, utot);
           else         leidenInitializeOmpW(vcom, ctot, y, vtot);
           if (isFirst) fillValueOmpU(vaff.data(), x.order(), B(1));
           else         fillValueOmpU(vaff.data(), y.order(), B(1));
-          if (isFirst) m += leidenMoveOmpW<true>(ucom, ctot, vaff, vcs, vcout, x, vcob, utot, M, R, L, fc);
-          else         m += leidenMoveOmpW<true>(vcom, ctot, vaff, vcs, vcout, y, vcob, vtot, M, R, L, fc);
-        });
+          if (isFirst) m += leidenMoveOmpW<true>(ucom, ctot, vaff, vcs, vcout, x, vcob, utot, M, R, L, fc, &pl);
+          else         m += leidenMoveOmpW<true>(vcom, ctot, vaff, vcs, vcout, y, vcob, vtot, M, R, L, fc, &pl);
+        }); tr += dr;
+        GVE_PROFILE_DO(pl.record("refine", -1, dr));
         l += max(m, 1); ++p;
-        if (m<=1 || p>=P) break;
+        // Dynamic runs start from a converged membership, so local-moving may not move any vertex
+        // in the first pass. Its refined (connected) communities must still be aggregated.
+        if ((m<=1 && !(DYNAMIC && isFirst)) || p>=P) break;
+        GVE_PROFILE_DO(auto t2 = timeNow());
         size_t GN = isFirst? x.order() : y.order();
         size_t CN = 0;
         if (isFirst) CN = leidenCommunityExistsOmpW(cv.degrees, x, ucom);
@@ -1287,13 +1326,15 @@ inline auto leidenInvokeOmp(const G& x, const LeidenOptions& o, FI fi, FM fm, FA
         else         leidenRenumberCommunitiesOmpW(vcom, cv.degrees, bufk, y);
         if (isFirst) {}
         else         leidenLookupCommunitiesOmpU(ucom, vcom);
-        ta += measureDuration([&]() {
+        GVE_PROFILE_DO(pl.record("renumber", -1, duration(t2), CN));
+        float da = measureDuration([&]() {
           cv.respan(CN); z.respan(CN);
           if (isFirst) leidenCommunityVerticesOmpW(cv.offsets, cv.degrees, cv.edgeKeys, bufk, x, ucom);
           else         leidenCommunityVerticesOmpW(cv.offsets, cv.degrees, cv.edgeKeys, bufk, y, vcom);
           if (isFirst) leidenAggregateOmpW(z.offsets, z.degrees, z.edgeKeys, z.edgeValues, bufs, vcs, vcout, x, ucom, cv.offsets, cv.edgeKeys);
           else         leidenAggregateOmpW(z.offsets, z.degrees, z.edgeKeys, z.edgeValues, bufs, vcs, vcout, y, vcom, cv.offsets, cv.edgeKeys);
-        });
+        }); ta += da;
+        GVE_PROFILE_DO(pl.record("aggregate", -1, da, CN, z.size()));
         swap(y, z);
         // fillValueOmpU(vcob.data(), CN, K());
         // fillValueOmpU(vcom.data(), CN, K());
@@ -1311,7 +1352,9 @@ inline auto leidenInvokeOmp(const G& x, const LeidenOptions& o, FI fi, FM fm, FA
     });
   }, o.repeat);
   leidenFreeHashtablesW(vcs, vcout);
-  return LeidenResult<K>(ucom, utot, ctot, l, p, t, tm/o.repeat, ti/o.repeat, tp/o.repeat, tl/o.repeat, tr/o.repeat, ta/o.repeat, countValueOmp(vaff, B(1)));
+  LeidenResult<K> a(ucom, utot, ctot, l, p, t, tm/o.repeat, ti/o.repeat, tp/o.repeat, tl/o.repeat, tr/o.repeat, ta/o.repeat, countValueOmp(vaff, B(1)));
+  a.profile = std::move(pl);
+  return a;
 }
 #endif
 #pragma endregion
@@ -1329,9 +1372,11 @@ inline auto leidenInvokeOmp(const G& x, const LeidenOptions& o, FI fi, FM fm, FA
  * @param qvtot initial total vertex weights
  * @param qctot initial total community weights
  * @param repeat number of runs
+ * @param S span of updated graph (new vertices are placed in their own communities)
  */
 template <class K, class W>
-inline void leidenSetupInitialsW(vector2d<K>& qs, vector2d<W>& qvtots, vector2d<W>& qctots, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, int repeat) {
+inline void leidenSetupInitialsW(vector2d<K>& qs, vector2d<W>& qvtots, vector2d<W>& qctots, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, int repeat, size_t S=0) {
+  size_t Q = q.size();
   qs    .resize(repeat);
   qvtots.resize(repeat);
   qctots.resize(repeat);
@@ -1339,6 +1384,12 @@ inline void leidenSetupInitialsW(vector2d<K>& qs, vector2d<W>& qvtots, vector2d<
     qs[r]     = q;
     qvtots[r] = qvtot;
     qctots[r] = qctot;
+    if (S<=Q) continue;
+    qs[r]    .resize(S);
+    qvtots[r].resize(S);
+    qctots[r].resize(S);
+    for (size_t u=Q; u<S; ++u)
+      qs[r][u] = K(u);
   }
 }
 #pragma endregion
@@ -1390,6 +1441,380 @@ inline auto leidenStaticOmp(const G& x, const LeidenOptions& o={}) {
 }
 #endif
 #pragma endregion
+
+
+
+
+#pragma region DYNAMIC APPROACHES
+/**
+ * Find the vertices which should be processed upon a batch of edge deletions and insertions, with Delta-screening.
+ * @param vertices vertices to process (output)
+ * @param neighbors neighbors of which to process (scratch)
+ * @param communities communities of which to process (scratch)
+ * @param vcs communities vertex u is linked to (temporary buffer, updated)
+ * @param vcout total edge weight from vertex u to community C (temporary buffer, updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update (sorted by source vertex)
+ * @param vcom community each vertex belongs to
+ * @param vtot total edge weight of each vertex
+ * @param ctot total edge weight of each community
+ * @param o leiden options
+ */
+template <class B, class G, class K, class V, class W, class A>
+inline void leidenAffectedVerticesDeltaScreeningW(vector<B>& vertices, vector<B>& neighbors, vector<B>& communities, vector<K>& vcs, A& vcout, const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& vcom, const vector<W>& vtot, const vector<W>& ctot, const LeidenOptions& o) {
+  double R = o.resolution;
+  double M = edgeWeight(y)/2;
+  size_t I = insertions.size();
+  fillValueU(vertices,    B());
+  fillValueU(neighbors,   B());
+  fillValueU(communities, B());
+  for (auto [u, v, w] : deletions) {
+    if (vcom[u] != vcom[v]) continue;
+    vertices[u]  = B(1);
+    neighbors[u] = B(1);
+    communities[vcom[v]] = B(1);
+  }
+  for (size_t i=0; i<I;) {
+    K u = get<0>(insertions[i]);
+    leidenClearScanW(vcs, vcout);
+    for (; i<I && get<0>(insertions[i])==u; ++i) {
+      K v = get<1>(insertions[i]);
+      V w = get<2>(insertions[i]);
+      if (vcom[u] == vcom[v]) continue;
+      leidenScanCommunityW(vcs, vcout, u, v, w, vcom);
+    }
+    auto [c, e] = leidenChooseCommunity(y, u, vcom, vtot, ctot, vcs, vcout, M, R);
+    if (e) { vertices[u] = B(1); neighbors[u] = B(1); communities[c] = B(1); }
+  }
+  y.forEachVertexKey([&](auto u) {
+    if (neighbors[u]) y.forEachEdgeKey(u, [&](auto v) { vertices[v] = B(1); });
+    if (communities[vcom[u]]) vertices[u] = B(1);
+  });
+}
+
+
+#ifdef _OPENMP
+/**
+ * Find the vertices which should be processed upon a batch of edge deletions and insertions, with Delta-screening.
+ * @param vertices vertices to process (output)
+ * @param neighbors neighbors of which to process (scratch)
+ * @param communities communities of which to process (scratch)
+ * @param vcs communities vertex u is linked to (temporary buffer, updated)
+ * @param vcout total edge weight from vertex u to community C (temporary buffer, updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update (sorted by source vertex)
+ * @param vcom community each vertex belongs to
+ * @param vtot total edge weight of each vertex
+ * @param ctot total edge weight of each community
+ * @param o leiden options
+ */
+template <class B, class G, class K, class V, class W, class A>
+inline void leidenAffectedVerticesDeltaScreeningOmpW(vector<B>& vertices, vector<B>& neighbors, vector<B>& communities, vector<vector<K>*>& vcs, vector<A*>& vcout, const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& vcom, const vector<W>& vtot, const vector<W>& ctot, const LeidenOptions& o) {
+  size_t S = y.span();
+  double R = o.resolution;
+  double M = edgeWeightOmp(y)/2;
+  size_t I = insertions.size();
+  fillValueOmpU(vertices,    B());
+  fillValueOmpU(neighbors,   B());
+  fillValueOmpU(communities, B());
+  #pragma omp parallel
+  {
+    int t = omp_get_thread_num();
+    for (auto [u, v, w] : deletions) {
+      if (vcom[u] != vcom[v]) continue;
+      if (belongsOmp(u))       { vertices[u] = B(1); neighbors[u] = B(1); }
+      if (belongsOmp(vcom[v])) communities[vcom[v]] = B(1);
+    }
+    for (size_t i=0; i<I;) {
+      K u = get<0>(insertions[i]);
+      if (!belongsOmp(u)) { for (; i<I && get<0>(insertions[i])==u; ++i); continue; }
+      leidenClearScanW(*vcs[t], *vcout[t]);
+      for (; i<I && get<0>(insertions[i])==u; ++i) {
+        K v = get<1>(insertions[i]);
+        V w = get<2>(insertions[i]);
+        if (vcom[u] == vcom[v]) continue;
+        leidenScanCommunityW(*vcs[t], *vcout[t], u, v, w, vcom);
+      }
+      auto [c, e] = leidenChooseCommunity(y, u, vcom, vtot, ctot, *vcs[t], *vcout[t], M, R);
+      if (e) { vertices[u] = B(1); neighbors[u] = B(1); communities[c] = B(1); }
+    }
+  }
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (K u=0; u<S; ++u) {
+    if (!y.hasVertex(u)) continue;
+    if (neighbors[u]) y.forEachEdgeKey(u, [&](auto v) { vertices[v] = B(1); });
+    if (communities[vcom[u]]) vertices[u] = B(1);
+  }
+}
+#endif
+
+
+/**
+ * Find the vertices which should be processed upon a batch of edge deletions and insertions, with Dynamic Frontier approach.
+ * @param vertices vertices to process (output)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param vcom community each vertex belongs to
+ */
+template <class B, class G, class K, class V>
+inline void leidenAffectedVerticesFrontierW(vector<B>& vertices, const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& vcom) {
+  fillValueU(vertices, B());
+  for (auto [u, v, w] : deletions) {
+    if (vcom[u] != vcom[v]) continue;
+    vertices[u] = B(1);
+    vertices[v] = B(1);
+  }
+  for (auto [u, v, w] : insertions) {
+    if (vcom[u] == vcom[v]) continue;
+    vertices[u] = B(1);
+    vertices[v] = B(1);
+  }
+}
+
+
+#ifdef _OPENMP
+/**
+ * Find the vertices which should be processed upon a batch of edge deletions and insertions, with Dynamic Frontier approach.
+ * @param vertices vertices to process (output)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param vcom community each vertex belongs to
+ */
+template <class B, class G, class K, class V>
+inline void leidenAffectedVerticesFrontierOmpW(vector<B>& vertices, const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& vcom) {
+  fillValueOmpU(vertices, B());
+  #pragma omp parallel
+  {
+    for (auto [u, v, w] : deletions) {
+      if (vcom[u] != vcom[v]) continue;
+      if (belongsOmp(u)) vertices[u] = B(1);
+      if (belongsOmp(v)) vertices[v] = B(1);
+    }
+    for (auto [u, v, w] : insertions) {
+      if (vcom[u] == vcom[v]) continue;
+      if (belongsOmp(u)) vertices[u] = B(1);
+      if (belongsOmp(v)) vertices[v] = B(1);
+    }
+  }
+}
+#endif
+
+
+/**
+ * Obtain the community membership of each vertex with Naive-dynamic Leiden.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o leiden options
+ * @returns leiden result
+ */
+template <class G, class K, class V, class W>
+inline auto leidenNaiveDynamic(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LeidenOptions& o={}) {
+  using B = char;
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  leidenSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    leidenUpdateWeightsFromU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [ ](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    fillValueU(vaff, B(1));
+  };
+  auto fa = [ ](auto u) { return true; };
+  return leidenInvoke<true>(y, o, fi, fm, fa);
+}
+
+
+#ifdef _OPENMP
+/**
+ * Obtain the community membership of each vertex with Naive-dynamic Leiden.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o leiden options
+ * @returns leiden result
+ */
+template <class G, class K, class V, class W>
+inline auto leidenNaiveDynamicOmp(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LeidenOptions& o={}) {
+  using B = char;
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  leidenSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    leidenUpdateWeightsFromOmpU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [ ](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    fillValueOmpU(vaff, B(1));
+  };
+  auto fa = [ ](auto u) { return true; };
+  return leidenInvokeOmp<true>(y, o, fi, fm, fa);
+}
+#endif
+
+
+/**
+ * Obtain the community membership of each vertex with Delta-screening based Dynamic Leiden.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update (sorted by source vertex)
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o leiden options
+ * @returns leiden result
+ */
+template <class G, class K, class V, class W>
+inline auto leidenDynamicDeltaScreening(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LeidenOptions& o={}) {
+  using B = char;
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  vector<B> vertices(S), neighbors(S), communities(S);
+  leidenSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    leidenUpdateWeightsFromU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [&](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    leidenAffectedVerticesDeltaScreeningW(vertices, neighbors, communities, vcs, vcout, y, deletions, insertions, vcom, vtot, ctot, o);
+    copyValuesW(vaff, vertices);
+  };
+  auto fa = [&](auto u) { return vertices[u] == B(1); };
+  return leidenInvoke<true>(y, o, fi, fm, fa);
+}
+
+
+#ifdef _OPENMP
+/**
+ * Obtain the community membership of each vertex with Delta-screening based Dynamic Leiden.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update (sorted by source vertex)
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o leiden options
+ * @returns leiden result
+ */
+template <class G, class K, class V, class W>
+inline auto leidenDynamicDeltaScreeningOmp(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LeidenOptions& o={}) {
+  using B = char;
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  vector<B> vertices(S), neighbors(S), communities(S);
+  leidenSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    leidenUpdateWeightsFromOmpU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [&](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    leidenAffectedVerticesDeltaScreeningOmpW(vertices, neighbors, communities, vcs, vcout, y, deletions, insertions, vcom, vtot, ctot, o);
+    copyValuesOmpW(vaff, vertices);
+  };
+  auto fa = [&](auto u) { return vertices[u] == B(1); };
+  return leidenInvokeOmp<true>(y, o, fi, fm, fa);
+}
+#endif
+
+
+/**
+ * Obtain the community membership of each vertex with Dynamic Frontier Leiden.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o leiden options
+ * @returns leiden result
+ */
+template <class G, class K, class V, class W>
+inline auto leidenDynamicFrontier(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LeidenOptions& o={}) {
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  leidenSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    leidenUpdateWeightsFromU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [&](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    leidenAffectedVerticesFrontierW(vaff, y, deletions, insertions, vcom);
+  };
+  auto fa = [ ](auto u) { return true; };
+  return leidenInvoke<true>(y, o, fi, fm, fa);
+}
+
+
+#ifdef _OPENMP
+/**
+ * Obtain the community membership of each vertex with Dynamic Frontier Leiden.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o leiden options
+ * @returns leiden result
+ */
+template <class G, class K, class V, class W>
+inline auto leidenDynamicFrontierOmp(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LeidenOptions& o={}) {
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  leidenSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    leidenUpdateWeightsFromOmpU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [&](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    leidenAffectedVerticesFrontierOmpW(vaff, y, deletions, insertions, vcom);
+  };
+  auto fa = [ ](auto u) { return true; };
+  return leidenInvokeOmp<true>(y, o, fi, fm, fa);
+}
+#endif
+#pragma endregion
 #pragma endregion
 } // namespace detail
 } // namespace gve
@@ -1426,7 +1851,12 @@ EXPORT namespace gve {
   // using detail::leidenAggregateW;
   // using detail::leidenInvoke;
   // using detail::leidenSetupInitialsW;
+  // using detail::leidenAffectedVerticesDeltaScreeningW;
+  // using detail::leidenAffectedVerticesFrontierW;
   using detail::leidenStatic;
+  using detail::leidenNaiveDynamic;
+  using detail::leidenDynamicDeltaScreening;
+  using detail::leidenDynamicFrontier;
 #ifdef _OPENMP
   // using detail::leidenVertexWeightsOmpW;
   // using detail::leidenCommunityWeightsOmpW;
@@ -1444,6 +1874,11 @@ EXPORT namespace gve {
   // using detail::leidenRenumberCommunitiesOmpW;
   // using detail::leidenAggregateOmpW;
   // using detail::leidenInvokeOmp;
+  // using detail::leidenAffectedVerticesDeltaScreeningOmpW;
+  // using detail::leidenAffectedVerticesFrontierOmpW;
   using detail::leidenStaticOmp;
+  using detail::leidenNaiveDynamicOmp;
+  using detail::leidenDynamicDeltaScreeningOmp;
+  using detail::leidenDynamicFrontierOmp;
 #endif
 } // namespace gve
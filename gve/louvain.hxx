@@ -26,6 +26,7 @@ using std::tuple;
 using std::vector;
 using std::move;
 using std::swap;
+using std::get;
 using std::min;
 using std::max;
 
@@ -110,6 +111,8 @@ struct LouvainResult {
   float aggregationTime;
   /** Number of vertices initially marked as affected. */
   size_t affectedVertices;
+  /** Statistics of each pass and iteration (recorded only with GVE_PROFILE). */
+  ProfileLog profile;
   #pragma endregion
 
 
@@ -165,12 +168,12 @@ struct LouvainResult {
  * @param vcout total edge weight from vertex u to community C (updated)
  * @param S size of each hashtable
  */
-template <class K, class W>
-inline void louvainAllocateHashtablesW(vector<vector<K>*>& vcs, vector<vector<W>*>& vcout, size_t S) {
+template <class K, class A>
+inline void louvainAllocateHashtablesW(vector<vector<K>*>& vcs, vector<A*>& vcout, size_t S) {
   size_t N = vcs.size();
   for (size_t i=0; i<N; ++i) {
     vcs[i]   = new vector<K>();
-    vcout[i] = new vector<W>(S);
+    vcout[i] = new A(S);
   }
 }
 
@@ -180,8 +183,8 @@ inline void louvainAllocateHashtablesW(vector<vector<K>*>& vcs, vector<vector<W>
  * @param vcs communities vertex u is linked to (updated)
  * @param vcout total edge weight from vertex u to community C (updated)
  */
-template <class K, class W>
-inline void louvainFreeHashtablesW(vector<vector<K>*>& vcs, vector<vector<W>*>& vcout) {
+template <class K, class A>
+inline void louvainFreeHashtablesW(vector<vector<K>*>& vcs, vector<A*>& vcout) {
   size_t N = vcs.size();
   for (size_t i=0; i<N; ++i) {
     delete vcs[i];
@@ -411,12 +414,13 @@ inline void louvainUpdateWeightsFromOmpU(vector<W>& vtot, vector<W>& ctot, const
  * @param w outgoing edge weight
  * @param vcom community each vertex belongs to
  */
-template <bool SELF=false, class K, class V, class W>
-inline void louvainScanCommunityW(vector<K>& vcs, vector<W>& vcout, K u, K v, V w, const vector<K>& vcom) {
+template <bool SELF=false, class K, class V, class A>
+inline void louvainScanCommunityW(vector<K>& vcs, A& vcout, K u, K v, V w, const vector<K>& vcom) {
   if (!SELF && u==v) return;
   K c = vcom[v];
-  if (!vcout[c]) vcs.push_back(c);
-  vcout[c] += w;
+  auto& a = vcout[c];
+  if (!a) vcs.push_back(c);
+  a += w;
 }
 
 
@@ -428,8 +432,8 @@ inline void louvainScanCommunityW(vector<K>& vcs, vector<W>& vcout, K u, K v, V
  * @param u given vertex
  * @param vcom community each vertex belongs to
  */
-template <bool SELF=false, class G, class K, class W>
-inline void louvainScanCommunitiesW(vector<K>& vcs, vector<W>& vcout, const G& x, K u, const vector<K>& vcom) {
+template <bool SELF=false, class G, class K, class A>
+inline void louvainScanCommunitiesW(vector<K>& vcs, A& vcout, const G& x, K u, const vector<K>& vcom) {
   x.forEachEdge(u, [&](auto v, auto w) { louvainScanCommunityW<SELF>(vcs, vcout, u, v, w, vcom); });
 }
 
@@ -447,6 +451,18 @@ inline void louvainClearScanW(vector<K>& vcs, vector<W>& vcout) {
 }
 
 
+/**
+ * Clear communities scan data, in a scan accumulator.
+ * @param vcs communities vertex u is linked to (updated)
+ * @param vcout total edge weight from vertex u to community C (updated)
+ */
+template <class K, class W>
+inline void louvainClearScanW(vector<K>& vcs, ScanAccumulator<K, W>& vcout) {
+  vcout.clear();
+  vcs.clear();
+}
+
+
 /**
  * Choose connected community with best delta modularity.
  * @param x original graph
@@ -460,13 +476,13 @@ inline void louvainClearScanW(vector<K>& vcs, vector<W>& vcout) {
  * @param R resolution (0, 1]
  * @returns [best community, delta modularity]
  */
-template <bool SELF=false, class G, class K, class W>
-inline auto louvainChooseCommunity(const G& x, K u, const vector<K>& vcom, const vector<W>& vtot, const vector<W>& ctot, const vector<K>& vcs, const vector<W>& vcout, double M, double R) {
+template <bool SELF=false, class G, class K, class W, class A>
+inline auto louvainChooseCommunity(const G& x, K u, const vector<K>& vcom, const vector<W>& vtot, const vector<W>& ctot, const vector<K>& vcs, const A& vcout, double M, double R) {
   K cmax = K(), d = vcom[u];
-  W emax = W();
+  W emax = W(), vdout = vcout[d];
   for (K c : vcs) {
     if (!SELF && c==d) continue;
-    W e = deltaModularity(vcout[c], vcout[d], vtot[u], ctot[c], ctot[d], M, R);
+    W e = deltaModularity(vcout[c], vdout, vtot[u], ctot[c], ctot[d], M, R);
     if (e>emax) { emax = e; cmax = c; }
   }
   return std::make_pair(cmax, emax);
@@ -533,8 +549,8 @@ inline void louvainChangeCommunityOmpW(vector<K>& vcom, vector<W>& ctot, const G
  * @param fa is vertex allowed to be updated?
  * @returns iterations performed (0 if converged already)
  */
-template <class G, class K, class W, class B, class FC, class FA>
-inline int louvainMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<K>& vcs, vector<W>& vcout, const G& x, const vector<W>& vtot, double M, double R, int L, FC fc, FA fa) {
+template <class G, class K, class W, class B, class FC, class FA, class A>
+inline int louvainMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<K>& vcs, A& vcout, const G& x, const vector<W>& vtot, double M, double R, int L, FC fc, FA fa) {
   int l = 0;
   W  el = W();
   for (; l<L;) {
@@ -569,8 +585,8 @@ inline int louvainMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vecto
  * @param fc has local moving phase converged?
  * @returns iterations performed (0 if converged already)
  */
-template <class G, class K, class W, class B, class FC>
-inline int louvainMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<K>& vcs, vector<W>& vcout, const G& x, const vector<W>& vtot, double M, double R, int L, FC fc) {
+template <class G, class K, class W, class B, class FC, class A>
+inline int louvainMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<K>& vcs, A& vcout, const G& x, const vector<W>& vtot, double M, double R, int L, FC fc) {
   auto fa = [](auto u) { return true; };
   return louvainMoveW(vcom, ctot, vaff, vcs, vcout, x, vtot, M, R, L, fc, fa);
 }
@@ -591,27 +607,36 @@ inline int louvainMoveW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vecto
  * @param L max iterations
  * @param fc has local moving phase converged?
  * @param fa is vertex allowed to be updated?
+ * @param pl profile log (optional)
  * @returns iterations performed (0 if converged already)
  */
-template <class G, class K, class W, class B, class FC, class FA>
-inline int louvainMoveOmpW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<vector<K>*>& vcs, vector<vector<W>*>& vcout, const G& x, const vector<W>& vtot, double M, double R, int L, FC fc, FA fa) {
+template <class G, class K, class W, class B, class FC, class FA, class A>
+inline int louvainMoveOmpW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<vector<K>*>& vcs, vector<A*>& vcout, const G& x, const vector<W>& vtot, double M, double R, int L, FC fc, FA fa, ProfileLog *pl=nullptr) {
   size_t S = x.span();
   int l = 0;
   W  el = W();
   for (; l<L;) {
     el = W();
-    #pragma omp parallel for schedule(dynamic, 2048) reduction(+:el)
-    for (K u=0; u<S; ++u) {
+    GVE_PROFILE_DO(auto t0 = timeNow());
+    #pragma omp parallel reduction(+:el)
+    {
       int t = omp_get_thread_num();
-      if (!x.hasVertex(u)) continue;
-      if (!fa(u) || !vaff[u]) continue;
-      louvainClearScanW(*vcs[t], *vcout[t]);
-      louvainScanCommunitiesW(*vcs[t], *vcout[t], x, u, vcom);
-      auto [c, e] = louvainChooseCommunity(x, u, vcom, vtot, ctot, *vcs[t], *vcout[t], M, R);
-      if (c)      { louvainChangeCommunityOmpW(vcom, ctot, x, u, c, vtot); x.forEachEdgeKey(u, [&](auto v) { vaff[v] = B(1); }); }
-      vaff[u] = B();
-      el += e;  // l1-norm
+      GVE_PROFILE_DO(auto t1 = timeNow(); size_t na = 0, nc = 0, ne = 0);
+      #pragma omp for schedule(dynamic, 2048) nowait
+      for (K u=0; u<S; ++u) {
+        if (!x.hasVertex(u)) continue;
+        if (!fa(u) || !vaff[u]) continue;
+        louvainClearScanW(*vcs[t], *vcout[t]);
+        louvainScanCommunitiesW(*vcs[t], *vcout[t], x, u, vcom);
+        auto [c, e] = louvainChooseCommunity(x, u, vcom, vtot, ctot, *vcs[t], *vcout[t], M, R);
+        if (c)      { louvainChangeCommunityOmpW(vcom, ctot, x, u, c, vtot); x.forEachEdgeKey(u, [&](auto v) { vaff[v] = B(1); }); GVE_PROFILE_DO(++nc); }
+        vaff[u] = B();
+        el += e;  // l1-norm
+        GVE_PROFILE_DO(++na; ne += x.degree(u));
+      }
+      GVE_PROFILE_DO(if (pl) pl->countU(t, na, nc, ne, duration(t1)));
     }
+    GVE_PROFILE_DO(if (pl) pl->recordThreads("move", l, duration(t0)));
     if (fc(el, l++)) break;
   }
   return l>1 || el? l : 0;
@@ -631,12 +656,13 @@ inline int louvainMoveOmpW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, ve
  * @param R resolution (0, 1]
  * @param L max iterations
  * @param fc has local moving phase converged?
+ * @param pl profile log (optional)
  * @returns iterations performed (0 if converged already)
  */
-template <class G, class K, class W, class B, class FC>
-inline int louvainMoveOmpW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<vector<K>*>& vcs, vector<vector<W>*>& vcout, const G& x, const vector<W>& vtot, double M, double R, int L, FC fc) {
+template <class G, class K, class W, class B, class FC, class A>
+inline int louvainMoveOmpW(vector<K>& vcom, vector<W>& ctot, vector<B>& vaff, vector<vector<K>*>& vcs, vector<A*>& vcout, const G& x, const vector<W>& vtot, double M, double R, int L, FC fc, ProfileLog *pl=nullptr) {
   auto fa = [](auto u) { return true; };
-  return louvainMoveOmpW(vcom, ctot, vaff, vcs, vcout, x, vtot, M, R, L, fc, fa);
+  return louvainMoveOmpW(vcom, ctot, vaff, vcs, vcout, x, vtot, M, R, L, fc, fa, pl);
 }
 #endif
 #pragma endregion
@@ -871,8 +897,8 @@ inline void louvainLookupCommunitiesOmpU(vector<K>& a, const vector<K>& vcom) {
  * @param cedg vertices belonging to each community
  * @param yoff offsets for vertices belonging to each community
  */
-template <class G, class K, class W>
-inline void louvainAggregateEdgesW(vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<K>& vcs, vector<W>& vcout, const G& x, const vector<K>& vcom, const vector<K>& coff, const vector<K>& cedg, const vector<size_t>& yoff) {
+template <class G, class K, class W, class A>
+inline void louvainAggregateEdgesW(vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<K>& vcs, A& vcout, const G& x, const vector<K>& vcom, const vector<K>& coff, const vector<K>& cedg, const vector<size_t>& yoff) {
   size_t C = coff.size() - 1;
   fillValueU(ydeg, K());
   for (K c=0; c<C; ++c) {
@@ -902,8 +928,8 @@ inline void louvainAggregateEdgesW(vector<K>& ydeg, vector<K>& yedg, vector<W>&
  * @param cedg vertices belonging to each community
  * @param yoff offsets for vertices belonging to each community
  */
-template <class G, class K, class W>
-inline void louvainAggregateEdgesOmpW(vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<vector<K>*>& vcs, vector<vector<W>*>& vcout, const G& x, const vector<K>& vcom, const vector<K>& coff, const vector<K>& cedg, const vector<size_t>& yoff) {
+template <class G, class K, class W, class A>
+inline void louvainAggregateEdgesOmpW(vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<vector<K>*>& vcs, vector<A*>& vcout, const G& x, const vector<K>& vcom, const vector<K>& coff, const vector<K>& cedg, const vector<size_t>& yoff) {
   size_t C = coff.size() - 1;
   fillValueOmpU(ydeg, K());
   #pragma omp parallel for schedule(dynamic, 2048)
@@ -968,8 +994,8 @@ inline size_t louvainRenumberCommunitiesOmpW(vector<K>& vcom, vector<K>& cext, v
  * @param coff offsets for vertices belonging to each community
  * @param cedg vertices belonging to each community
  */
-template <class G, class K, class W>
-inline void louvainAggregateW(vector<size_t>& yoff, vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<K>& vcs, vector<W>& vcout, const G& x, const vector<K>& vcom, vector<K>& coff, vector<K>& cedg) {
+template <class G, class K, class W, class A>
+inline void louvainAggregateW(vector<size_t>& yoff, vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<K>& vcs, A& vcout, const G& x, const vector<K>& vcom, vector<K>& coff, vector<K>& cedg) {
   size_t C = coff.size() - 1;
   louvainCommunityTotalDegreeW(yoff, x, vcom);
   yoff[C] = exclusiveScanW(yoff.data(), yoff.data(), C);
@@ -992,8 +1018,8 @@ inline void louvainAggregateW(vector<size_t>& yoff, vector<K>& ydeg, vector<K>&
  * @param coff offsets for vertices belonging to each community
  * @param cedg vertices belonging to each community
  */
-template <class G, class K, class W>
-inline void louvainAggregateOmpW(vector<size_t>& yoff, vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<size_t>& bufs, vector<vector<K>*>& vcs, vector<vector<W>*>& vcout, const G& x, const vector<K>& vcom, vector<K>& coff, vector<K>& cedg) {
+template <class G, class K, class W, class A>
+inline void louvainAggregateOmpW(vector<size_t>& yoff, vector<K>& ydeg, vector<K>& yedg, vector<W>& ywei, vector<size_t>& bufs, vector<vector<K>*>& vcs, vector<A*>& vcout, const G& x, const vector<K>& vcom, vector<K>& coff, vector<K>& cedg) {
   size_t C = coff.size() - 1;
   louvainCommunityTotalDegreeOmpW(yoff, x, vcom);
   yoff[C] = exclusiveScanOmpW(yoff.data(), bufs.data(), yoff.data(), C);
@@ -1147,7 +1173,7 @@ inline auto louvainInvokeOmp(const G& x, const LouvainOptions& o, FI fi, FM fm,
   vector<K> bufk(T);        // Buffer for exclusive scan
   vector<size_t> bufs(T);   // Buffer for exclusive scan
   vector<vector<K>*> vcs(T);    // Hashtable keys
-  vector<vector<W>*> vcout(T);  // Hashtable values
+  vector<ScanAccumulator<K, W>*> vcout(T);  // Hashtable values
   if (!DYNAMIC) ucom.resize(S);
   if (!DYNAMIC) utot.resize(S);
   if (!DYNAMIC) ctot.resize(S);
@@ -1157,6 +1183,7 @@ inline auto louvainInvokeOmp(const G& x, const LouvainOptions& o, FI fi, FM fm,
   DiGraphCsrVector<K, None, None, K> cv(S, S);  // CSR for community vertices
   DiGraphCsrVector<K, None, W> y(S, Y);         // CSR for aggregated graph (input);  y(S, X)
   DiGraphCsrVector<K, None, W> z(S, Z);         // CSR for aggregated graph (output); z(S, X)
+  ProfileLog pl;  // Statistics of each pass and iteration
   // Perform Louvain algorithm.
   float tm = 0, ti = 0, tp = 0, tl = 0, ta = 0;  // Time spent in different phases
   float t  = measureDurationMarked([&](auto mark) {
@@ -1169,6 +1196,7 @@ inline auto louvainInvokeOmp(const G& x, const LouvainOptions& o, FI fi, FM fm,
     fillValueOmpU(utot, W());
     fillValueOmpU(vtot, W());
     fillValueOmpU(ctot, W());
+    GVE_PROFILE_DO(pl.clear());
     cv.respan(S);
     y .respan(S);
     z .respan(S);
@@ -1177,7 +1205,8 @@ inline auto louvainInvokeOmp(const G& x, const LouvainOptions& o, FI fi, FM fm,
       // Initialize community membership and total vertex/community weights.
       ti += measureDuration([&]() { fi(ucom, utot, ctot); });
       // Mark affected vertices.
-      tm += measureDuration([&]() { fm(vaff, vcs, vcout, ucom, utot, ctot); });
+      float dm = measureDuration([&]() { fm(vaff, vcs, vcout, ucom, utot, ctot); }); tm += dm;
+      GVE_PROFILE_DO(pl.record("mark", -1, dm, x.order(), X); pl.records.back().affected = countValueOmp(vaff, B(1)));
       // Start timing first pass.
       auto t0 = timeNow(), t1 = t0;
       // Start local-moving, aggregation phases.
@@ -1187,12 +1216,15 @@ inline auto louvainInvokeOmp(const G& x, const LouvainOptions& o, FI fi, FM fm,
         if (p==1) t1 = timeNow();
         bool isFirst = p==0;
         int m = 0;
-        tl += measureDuration([&]() {
-          if (isFirst) m = louvainMoveOmpW(ucom, ctot, vaff, vcs, vcout, x, utot, M, R, L, fc, fa);
-          else         m = louvainMoveOmpW(vcom, ctot, vaff, vcs, vcout, y, vtot, M, R, L, fc);
-        });
+        GVE_PROFILE_DO(pl.pass = p);
+        float dl = measureDuration([&]() {
+          if (isFirst) m = louvainMoveOmpW(ucom, ctot, vaff, vcs, vcout, x, utot, M, R, L, fc, fa, &pl);
+          else         m = louvainMoveOmpW(vcom, ctot, vaff, vcs, vcout, y, vtot, M, R, L, fc, &pl);
+        }); tl += dl;
+        GVE_PROFILE_DO(pl.record("move", -1, dl, isFirst? x.order() : y.order(), isFirst? X : y.size()));
         l += max(m, 1); ++p;
         if (m<=1 || p>=P) break;
+        GVE_PROFILE_DO(auto t2 = timeNow());
         size_t GN = isFirst? x.order() : y.order();
         size_t GS = isFirst? x.span()  : y.span();
         size_t CN = 0;
@@ -1203,13 +1235,15 @@ inline auto louvainInvokeOmp(const G& x, const LouvainOptions& o, FI fi, FM fm,
         else         louvainRenumberCommunitiesOmpW(vcom, cv.degrees, bufk, y);
         if (isFirst) {}
         else         louvainLookupCommunitiesOmpU(ucom, vcom);
-        ta += measureDuration([&]() {
+        GVE_PROFILE_DO(pl.record("renumber", -1, duration(t2), CN));
+        float da = measureDuration([&]() {
           cv.respan(CN); z.respan(CN);
           if (isFirst) louvainCommunityVerticesOmpW(cv.offsets, cv.degrees, cv.edgeKeys, bufk, x, ucom);
           else         louvainCommunityVerticesOmpW(cv.offsets, cv.degrees, cv.edgeKeys, bufk, y, vcom);
           if (isFirst) louvainAggregateOmpW(z.offsets, z.degrees, z.edgeKeys, z.edgeValues, bufs, vcs, vcout, x, ucom, cv.offsets, cv.edgeKeys);
           else         louvainAggregateOmpW(z.offsets, z.degrees, z.edgeKeys, z.edgeValues, bufs, vcs, vcout, y, vcom, cv.offsets, cv.edgeKeys);
-        });
+        }); ta += da;
+        GVE_PROFILE_DO(pl.record("aggregate", -1, da, CN, z.size()));
         swap(y, z);
         // fillValueOmpU(vcom.data(), CN, K());
         // fillValueOmpU(ctot.data(), CN, W());
@@ -1226,7 +1260,9 @@ inline auto louvainInvokeOmp(const G& x, const LouvainOptions& o, FI fi, FM fm,
     });
   }, o.repeat);
   louvainFreeHashtablesW(vcs, vcout);
-  return LouvainResult<K, W>(ucom, utot, ctot, l, p, t, tm/o.repeat, ti/o.repeat, tp/o.repeat, tl/o.repeat, ta/o.repeat, countValueOmp(vaff, B(1)));
+  LouvainResult<K, W> a(ucom, utot, ctot, l, p, t, tm/o.repeat, ti/o.repeat, tp/o.repeat, tl/o.repeat, ta/o.repeat, countValueOmp(vaff, B(1)));
+  a.profile = std::move(pl);
+  return a;
 }
 #endif
 #pragma endregion
@@ -1244,9 +1280,11 @@ inline auto louvainInvokeOmp(const G& x, const LouvainOptions& o, FI fi, FM fm,
  * @param qvtot initial total vertex weights
  * @param qctot initial total community weights
  * @param repeat number of runs
+ * @param S span of updated graph (new vertices are placed in their own communities)
  */
 template <class K, class W>
-inline void louvainSetupInitialsW(vector2d<K>& qs, vector2d<W>& qvtots, vector2d<W>& qctots, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, int repeat) {
+inline void louvainSetupInitialsW(vector2d<K>& qs, vector2d<W>& qvtots, vector2d<W>& qctots, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, int repeat, size_t S=0) {
+  size_t Q = q.size();
   qs    .resize(repeat);
   qvtots.resize(repeat);
   qctots.resize(repeat);
@@ -1254,6 +1292,12 @@ inline void louvainSetupInitialsW(vector2d<K>& qs, vector2d<W>& qvtots, vector2d
     qs[r]     = q;
     qvtots[r] = qvtot;
     qctots[r] = qctot;
+    if (S<=Q) continue;
+    qs[r]    .resize(S);
+    qvtots[r].resize(S);
+    qctots[r].resize(S);
+    for (size_t u=Q; u<S; ++u)
+      qs[r][u] = K(u);
   }
 }
 #pragma endregion
@@ -1305,6 +1349,380 @@ inline auto louvainStaticOmp(const G& x, const LouvainOptions& o={}) {
 }
 #endif
 #pragma endregion
+
+
+
+
+#pragma region DYNAMIC APPROACHES
+/**
+ * Find the vertices which should be processed upon a batch of edge deletions and insertions, with Delta-screening.
+ * @param vertices vertices to process (output)
+ * @param neighbors neighbors of which to process (scratch)
+ * @param communities communities of which to process (scratch)
+ * @param vcs communities vertex u is linked to (temporary buffer, updated)
+ * @param vcout total edge weight from vertex u to community C (temporary buffer, updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update (sorted by source vertex)
+ * @param vcom community each vertex belongs to
+ * @param vtot total edge weight of each vertex
+ * @param ctot total edge weight of each community
+ * @param o louvain options
+ */
+template <class B, class G, class K, class V, class W, class A>
+inline void louvainAffectedVerticesDeltaScreeningW(vector<B>& vertices, vector<B>& neighbors, vector<B>& communities, vector<K>& vcs, A& vcout, const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& vcom, const vector<W>& vtot, const vector<W>& ctot, const LouvainOptions& o) {
+  double R = o.resolution;
+  double M = edgeWeight(y)/2;
+  size_t I = insertions.size();
+  fillValueU(vertices,    B());
+  fillValueU(neighbors,   B());
+  fillValueU(communities, B());
+  for (auto [u, v, w] : deletions) {
+    if (vcom[u] != vcom[v]) continue;
+    vertices[u]  = B(1);
+    neighbors[u] = B(1);
+    communities[vcom[v]] = B(1);
+  }
+  for (size_t i=0; i<I;) {
+    K u = get<0>(insertions[i]);
+    louvainClearScanW(vcs, vcout);
+    for (; i<I && get<0>(insertions[i])==u; ++i) {
+      K v = get<1>(insertions[i]);
+      V w = get<2>(insertions[i]);
+      if (vcom[u] == vcom[v]) continue;
+      louvainScanCommunityW(vcs, vcout, u, v, w, vcom);
+    }
+    auto [c, e] = louvainChooseCommunity(y, u, vcom, vtot, ctot, vcs, vcout, M, R);
+    if (e) { vertices[u] = B(1); neighbors[u] = B(1); communities[c] = B(1); }
+  }
+  y.forEachVertexKey([&](auto u) {
+    if (neighbors[u]) y.forEachEdgeKey(u, [&](auto v) { vertices[v] = B(1); });
+    if (communities[vcom[u]]) vertices[u] = B(1);
+  });
+}
+
+
+#ifdef _OPENMP
+/**
+ * Find the vertices which should be processed upon a batch of edge deletions and insertions, with Delta-screening.
+ * @param vertices vertices to process (output)
+ * @param neighbors neighbors of which to process (scratch)
+ * @param communities communities of which to process (scratch)
+ * @param vcs communities vertex u is linked to (temporary buffer, updated)
+ * @param vcout total edge weight from vertex u to community C (temporary buffer, updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update (sorted by source vertex)
+ * @param vcom community each vertex belongs to
+ * @param vtot total edge weight of each vertex
+ * @param ctot total edge weight of each community
+ * @param o louvain options
+ */
+template <class B, class G, class K, class V, class W, class A>
+inline void louvainAffectedVerticesDeltaScreeningOmpW(vector<B>& vertices, vector<B>& neighbors, vector<B>& communities, vector<vector<K>*>& vcs, vector<A*>& vcout, const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& vcom, const vector<W>& vtot, const vector<W>& ctot, const LouvainOptions& o) {
+  size_t S = y.span();
+  double R = o.resolution;
+  double M = edgeWeightOmp(y)/2;
+  size_t I = insertions.size();
+  fillValueOmpU(vertices,    B());
+  fillValueOmpU(neighbors,   B());
+  fillValueOmpU(communities, B());
+  #pragma omp parallel
+  {
+    int t = omp_get_thread_num();
+    for (auto [u, v, w] : deletions) {
+      if (vcom[u] != vcom[v]) continue;
+      if (belongsOmp(u))       { vertices[u] = B(1); neighbors[u] = B(1); }
+      if (belongsOmp(vcom[v])) communities[vcom[v]] = B(1);
+    }
+    for (size_t i=0; i<I;) {
+      K u = get<0>(insertions[i]);
+      if (!belongsOmp(u)) { for (; i<I && get<0>(insertions[i])==u; ++i); continue; }
+      louvainClearScanW(*vcs[t], *vcout[t]);
+      for (; i<I && get<0>(insertions[i])==u; ++i) {
+        K v = get<1>(insertions[i]);
+        V w = get<2>(insertions[i]);
+        if (vcom[u] == vcom[v]) continue;
+        louvainScanCommunityW(*vcs[t], *vcout[t], u, v, w, vcom);
+      }
+      auto [c, e] = louvainChooseCommunity(y, u, vcom, vtot, ctot, *vcs[t], *vcout[t], M, R);
+      if (e) { vertices[u] = B(1); neighbors[u] = B(1); communities[c] = B(1); }
+    }
+  }
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (K u=0; u<S; ++u) {
+    if (!y.hasVertex(u)) continue;
+    if (neighbors[u]) y.forEachEdgeKey(u, [&](auto v) { vertices[v] = B(1); });
+    if (communities[vcom[u]]) vertices[u] = B(1);
+  }
+}
+#endif
+
+
+/**
+ * Find the vertices which should be processed upon a batch of edge deletions and insertions, with Dynamic Frontier approach.
+ * @param vertices vertices to process (output)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param vcom community each vertex belongs to
+ */
+template <class B, class G, class K, class V>
+inline void louvainAffectedVerticesFrontierW(vector<B>& vertices, const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& vcom) {
+  fillValueU(vertices, B());
+  for (auto [u, v, w] : deletions) {
+    if (vcom[u] != vcom[v]) continue;
+    vertices[u] = B(1);
+    vertices[v] = B(1);
+  }
+  for (auto [u, v, w] : insertions) {
+    if (vcom[u] == vcom[v]) continue;
+    vertices[u] = B(1);
+    vertices[v] = B(1);
+  }
+}
+
+
+#ifdef _OPENMP
+/**
+ * Find the vertices which should be processed upon a batch of edge deletions and insertions, with Dynamic Frontier approach.
+ * @param vertices vertices to process (output)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param vcom community each vertex belongs to
+ */
+template <class B, class G, class K, class V>
+inline void louvainAffectedVerticesFrontierOmpW(vector<B>& vertices, const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& vcom) {
+  fillValueOmpU(vertices, B());
+  #pragma omp parallel
+  {
+    for (auto [u, v, w] : deletions) {
+      if (vcom[u] != vcom[v]) continue;
+      if (belongsOmp(u)) vertices[u] = B(1);
+      if (belongsOmp(v)) vertices[v] = B(1);
+    }
+    for (auto [u, v, w] : insertions) {
+      if (vcom[u] == vcom[v]) continue;
+      if (belongsOmp(u)) vertices[u] = B(1);
+      if (belongsOmp(v)) vertices[v] = B(1);
+    }
+  }
+}
+#endif
+
+
+/**
+ * Obtain the community membership of each vertex with Naive-dynamic Louvain.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o louvain options
+ * @returns louvain result
+ */
+template <class G, class K, class V, class W>
+inline auto louvainNaiveDynamic(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LouvainOptions& o={}) {
+  using B = char;
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  louvainSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    louvainUpdateWeightsFromU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [ ](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    fillValueU(vaff, B(1));
+  };
+  auto fa = [ ](auto u) { return true; };
+  return louvainInvoke<true>(y, o, fi, fm, fa);
+}
+
+
+#ifdef _OPENMP
+/**
+ * Obtain the community membership of each vertex with Naive-dynamic Louvain.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o louvain options
+ * @returns louvain result
+ */
+template <class G, class K, class V, class W>
+inline auto louvainNaiveDynamicOmp(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LouvainOptions& o={}) {
+  using B = char;
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  louvainSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    louvainUpdateWeightsFromOmpU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [ ](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    fillValueOmpU(vaff, B(1));
+  };
+  auto fa = [ ](auto u) { return true; };
+  return louvainInvokeOmp<true>(y, o, fi, fm, fa);
+}
+#endif
+
+
+/**
+ * Obtain the community membership of each vertex with Delta-screening based Dynamic Louvain.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update (sorted by source vertex)
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o louvain options
+ * @returns louvain result
+ */
+template <class G, class K, class V, class W>
+inline auto louvainDynamicDeltaScreening(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LouvainOptions& o={}) {
+  using B = char;
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  vector<B> vertices(S), neighbors(S), communities(S);
+  louvainSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    louvainUpdateWeightsFromU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [&](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    louvainAffectedVerticesDeltaScreeningW(vertices, neighbors, communities, vcs, vcout, y, deletions, insertions, vcom, vtot, ctot, o);
+    copyValuesW(vaff, vertices);
+  };
+  auto fa = [&](auto u) { return vertices[u] == B(1); };
+  return louvainInvoke<true>(y, o, fi, fm, fa);
+}
+
+
+#ifdef _OPENMP
+/**
+ * Obtain the community membership of each vertex with Delta-screening based Dynamic Louvain.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update (sorted by source vertex)
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o louvain options
+ * @returns louvain result
+ */
+template <class G, class K, class V, class W>
+inline auto louvainDynamicDeltaScreeningOmp(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LouvainOptions& o={}) {
+  using B = char;
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  vector<B> vertices(S), neighbors(S), communities(S);
+  louvainSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    louvainUpdateWeightsFromOmpU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [&](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    louvainAffectedVerticesDeltaScreeningOmpW(vertices, neighbors, communities, vcs, vcout, y, deletions, insertions, vcom, vtot, ctot, o);
+    copyValuesOmpW(vaff, vertices);
+  };
+  auto fa = [&](auto u) { return vertices[u] == B(1); };
+  return louvainInvokeOmp<true>(y, o, fi, fm, fa);
+}
+#endif
+
+
+/**
+ * Obtain the community membership of each vertex with Dynamic Frontier Louvain.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o louvain options
+ * @returns louvain result
+ */
+template <class G, class K, class V, class W>
+inline auto louvainDynamicFrontier(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LouvainOptions& o={}) {
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  louvainSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    louvainUpdateWeightsFromU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [&](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    louvainAffectedVerticesFrontierW(vaff, y, deletions, insertions, vcom);
+  };
+  auto fa = [ ](auto u) { return true; };
+  return louvainInvoke<true>(y, o, fi, fm, fa);
+}
+
+
+#ifdef _OPENMP
+/**
+ * Obtain the community membership of each vertex with Dynamic Frontier Louvain.
+ * @param y updated graph
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @param q initial community each vertex belongs to
+ * @param qvtot initial total edge weight of each vertex
+ * @param qctot initial total edge weight of each community
+ * @param o louvain options
+ * @returns louvain result
+ */
+template <class G, class K, class V, class W>
+inline auto louvainDynamicFrontierOmp(const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions, const vector<K>& q, const vector<W>& qvtot, const vector<W>& qctot, const LouvainOptions& o={}) {
+  size_t S = y.span();
+  int    r = 0;
+  vector2d<K> qs;
+  vector2d<W> qvtots, qctots;
+  louvainSetupInitialsW(qs, qvtots, qctots, q, qvtot, qctot, o.repeat, S);
+  auto fi = [&](auto& vcom, auto& vtot, auto& ctot) {
+    vcom = move(qs[r]);
+    vtot.assign(qvtots[r].begin(), qvtots[r].end());
+    ctot.assign(qctots[r].begin(), qctots[r].end());
+    louvainUpdateWeightsFromOmpU(vtot, ctot, y, deletions, insertions, vcom);
+    ++r;
+  };
+  auto fm = [&](auto& vaff, auto& vcs, auto& vcout, const auto& vcom, const auto& vtot, const auto& ctot) {
+    louvainAffectedVerticesFrontierOmpW(vaff, y, deletions, insertions, vcom);
+  };
+  auto fa = [ ](auto u) { return true; };
+  return louvainInvokeOmp<true>(y, o, fi, fm, fa);
+}
+#endif
+#pragma endregion
 #pragma endregion
 } // namespace detail
 } // namespace gve
@@ -1341,7 +1759,12 @@ EXPORT namespace gve {
   // using detail::louvainAggregateW;
   // using detail::louvainInvoke;
   // using detail::louvainSetupInitialsW;
+  // using detail::louvainAffectedVerticesDeltaScreeningW;
+  // using detail::louvainAffectedVerticesFrontierW;
   using detail::louvainStatic;
+  using detail::louvainNaiveDynamic;
+  using detail::louvainDynamicDeltaScreening;
+  using detail::louvainDynamicFrontier;
 #ifdef _OPENMP
   // using detail::louvainVertexWeightsOmpW;
   // using detail::louvainCommunityWeightsOmpW;
@@ -1359,6 +1782,11 @@ EXPORT namespace gve {
   // using detail::louvainRenumberCommunitiesOmpW;
   // using detail::louvainAggregateOmpW;
   // using detail::louvainInvokeOmp;
+  // using detail::louvainAffectedVerticesDeltaScreeningOmpW;
+  // using detail::louvainAffectedVerticesFrontierOmpW;
   using detail::louvainStaticOmp;
+  using detail::louvainNaiveDynamicOmp;
+  using detail::louvainDynamicDeltaScreeningOmp;
+  using detail::louvainDynamicFrontierOmp;
 #endif
 } // namespace gve
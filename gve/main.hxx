@@ -9,7 +9,10 @@
 #include "Graph.hxx"
 #include "update.hxx"
 #include "io.hxx"
+#include "snap.hxx"
+#include "snapshot.hxx"
 #include "csr.hxx"
+#include "compress.hxx"
 #include "duplicate.hxx"
 #include "transpose.hxx"
 #include "symmetrize.hxx"
@@ -17,9 +20,13 @@
 #include "properties.hxx"
 #include "dfs.hxx"
 #include "bfs.hxx"
+#include "components.hxx"
 #include "partition.hxx"
+#include "reorder.hxx"
 #include "batch.hxx"
+#include "versioned.hxx"
 #include "pagerank.hxx"
 #include "pagerankPrune.hxx"
+#include "pagerankMpi.hxx"
 #include "louvain.hxx"
 #include "leiden.hxx"
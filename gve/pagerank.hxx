@@ -4,11 +4,13 @@
 #pragma once
 
 #include <utility>
+#include <type_traits>
 #include <tuple>
 #include <vector>
 #include <algorithm>
 #include <cmath>
 #include "_main.hxx"
+#include "Graph.hxx"
 
 
 
@@ -22,6 +24,8 @@ using std::vector;
 using std::get;
 using std::abs;
 using std::max;
+using std::min;
+using std::lower_bound;
 
 
 
@@ -86,6 +90,8 @@ struct PagerankResult {
   float markingTime;
   /** Average time taken to compute ranks. */
   float computationTime;
+  /** Statistics of each iteration (recorded only with GVE_PROFILE). */
+  ProfileLog profile;
   #pragma endregion
 
 
@@ -204,16 +210,23 @@ inline V pagerankUpdateRanksAsync(vector<V>& a, const H& xt, V C0, V P, FA fa, F
  * @param P damping factor [0.85]
  * @param fa is vertex affected? (v)
  * @param fu called with previous and current vertex rank (v, rv, av)
+ * @param pl profile log (optional)
  */
 template <class H, class V, class FA, class FR>
-inline void pagerankUpdateRanksOmp(vector<V>& a, const H& xt, const vector<V>& r, V C0, V P, FA fa, FR fu) {
+inline void pagerankUpdateRanksOmp(vector<V>& a, const H& xt, const vector<V>& r, V C0, V P, FA fa, FR fu, ProfileLog *pl=nullptr) {
   using  K = typename H::key_type;
   size_t S = xt.span();
-  #pragma omp parallel for schedule(dynamic, 2048)
-  for (K v=0; v<S; ++v) {
-    if (!xt.hasVertex(v) || !fa(v)) continue;
-    V rv = pagerankUpdateRank(a, xt, r, v, C0, P);
-    fu(v, rv, a[v]);
+  #pragma omp parallel
+  {
+    GVE_PROFILE_DO(auto t1 = timeNow(); size_t na = 0, nc = 0, ne = 0);
+    #pragma omp for schedule(dynamic, 2048) nowait
+    for (K v=0; v<S; ++v) {
+      if (!xt.hasVertex(v) || !fa(v)) continue;
+      V rv = pagerankUpdateRank(a, xt, r, v, C0, P);
+      fu(v, rv, a[v]);
+      GVE_PROFILE_DO(++na; nc += rv!=a[v]; ne += xt.degree(v));
+    }
+    GVE_PROFILE_DO(if (pl) pl->countU(omp_get_thread_num(), na, nc, ne, duration(t1)));
   }
 }
 
@@ -226,18 +239,25 @@ inline void pagerankUpdateRanksOmp(vector<V>& a, const H& xt, const vector<V>& r
  * @param P damping factor [0.85]
  * @param fa is vertex affected? (v)
  * @param fu called with previous and current vertex rank (v, rv, av)
+ * @param pl profile log (optional)
  * @returns maximum change between previous and current rank values
  */
 template <class H, class V, class FA, class FR>
-inline V pagerankUpdateRanksAsyncOmp(vector<V>& a, const H& xt, V C0, V P, FA fa, FR fu) {
+inline V pagerankUpdateRanksAsyncOmp(vector<V>& a, const H& xt, V C0, V P, FA fa, FR fu, ProfileLog *pl=nullptr) {
   V el = V();
   size_t S = xt.span();
-  #pragma omp parallel for schedule(dynamic, 2048) reduction(max:el)
-  for (size_t v=0; v<S; ++v) {
-    if (!xt.hasVertex(v) || !fa(v)) continue;
-    V rv = pagerankUpdateRank(a, xt, a, v, C0, P);
-    fu(v, rv, a[v]);
-    el = max(el, abs(rv - a[v]));
+  #pragma omp parallel reduction(max:el)
+  {
+    GVE_PROFILE_DO(auto t1 = timeNow(); size_t na = 0, nc = 0, ne = 0);
+    #pragma omp for schedule(dynamic, 2048) nowait
+    for (size_t v=0; v<S; ++v) {
+      if (!xt.hasVertex(v) || !fa(v)) continue;
+      V rv = pagerankUpdateRank(a, xt, a, v, C0, P);
+      fu(v, rv, a[v]);
+      el = max(el, abs(rv - a[v]));
+      GVE_PROFILE_DO(++na; nc += rv!=a[v]; ne += xt.degree(v));
+    }
+    GVE_PROFILE_DO(if (pl) pl->countU(omp_get_thread_num(), na, nc, ne, duration(t1)));
   }
   return el;
 }
@@ -384,6 +404,23 @@ inline PagerankResult<V> pagerankInvoke(const H& xt, const PagerankOptions<V>& o
 
 
 #ifdef _OPENMP
+/**
+ * Count the affected vertices in a graph, for profiling (using OpenMP).
+ * @param xt transpose of original graph
+ * @param fa is vertex affected? (v)
+ * @returns number of affected vertices
+ */
+template <class H, class FA>
+inline size_t pagerankCountAffectedOmp(const H& xt, FA fa) {
+  using  K = typename H::key_type;
+  size_t S = xt.span(), n = 0;
+  #pragma omp parallel for schedule(static, 2048) reduction(+:n)
+  for (K v=0; v<S; ++v)
+    if (xt.hasVertex(v) && fa(v)) ++n;
+  return n;
+}
+
+
 /**
  * Setup and perform the PageRank algorithm (using OpenMP).
  * @param xt transpose of original graph
@@ -406,34 +443,259 @@ inline PagerankResult<V> pagerankInvokeOmp(const H& xt, const PagerankOptions<V>
   int L  = o.maxIterations, l = 0;
   vector<V> r(S), a;
   if (!ASYNC) a.resize(S);
+  ProfileLog pl;  // Statistics of each iteration
   float ti = 0, tm = 0, tc = 0;
   float t  = measureDuration([&]() {
+    GVE_PROFILE_DO(pl.clear());
     // Intitialize rank of each vertex.
     ti += measureDuration([&]() { fi(a, r); });
     // Mark affected vertices.
-    tm += measureDuration([&]() { fm(); });
+    float dm = measureDuration([&]() { fm(); }); tm += dm;
+    GVE_PROFILE_DO(pl.record("mark", -1, dm, N, xt.size()); pl.records.back().affected = pagerankCountAffectedOmp(xt, fa));
     // Compute ranks.
     tc += measureDuration([&]() {
       const V C0 = (1-P)/N;
       for (l=0; l<L;) {
+        GVE_PROFILE_DO(auto t0 = timeNow());
         if (ASYNC) {
           fc();  // Clear affected vertices
-          V el = pagerankUpdateRanksAsyncOmp(r, xt, C0, P, fa, fu); ++l;  // Update ranks of vertices
+          V el = pagerankUpdateRanksAsyncOmp(r, xt, C0, P, fa, fu, &pl); ++l;  // Update ranks of vertices
           fs();  // Swap current and previous affected vertices
+          GVE_PROFILE_DO(pl.recordThreads("iterate", l-1, duration(t0)));
           if (el<E) break;  // Check tolerance
         }
         else {
           fc();  // Clear affected vertices
-          pagerankUpdateRanksOmp(a, xt, r, C0, P, fa, fu); ++l;  // Update ranks of vertices
+          pagerankUpdateRanksOmp(a, xt, r, C0, P, fa, fu, &pl); ++l;  // Update ranks of vertices
           V el = liNormDeltaOmp(a, r);  // Compare previous and current ranks
           swap(a, r);       // Final ranks in (r)
           fs();  // Swap current and previous affected vertices
+          GVE_PROFILE_DO(pl.recordThreads("iterate", l-1, duration(t0)));
           if (el<E) break;  // Check tolerance
         }
       }
     });
   }, o.repeat);
-  return {r, l, t, ti/o.repeat, tm/o.repeat, tc/o.repeat};
+  PagerankResult<V> ans(r, l, t, ti/o.repeat, tm/o.repeat, tc/o.repeat);
+  ans.profile = std::move(pl);
+  return ans;
+}
+#endif
+#pragma endregion
+
+
+
+
+#pragma region CSR
+/**
+ * Compute the rank contribution of each vertex to its out-neighbors, over a CSR graph.
+ * @tparam F accumulator type
+ * @param c rank contribution of each vertex, r[u]/deg(u) (output)
+ * @param xt transpose of original graph, with out-degree as vertex value
+ * @param r rank of each vertex
+ * @param i begin vertex id
+ * @param I end vertex id
+ */
+template <class F, class K, class V, class E, class O, class T>
+inline void pagerankContributionsCsrW(F *c, const DiGraphCsr<K, V, E, O>& xt, const T *r, size_t i, size_t I) {
+  for (size_t u=i; u<I; ++u) {
+    K d  = xt.values[u];
+    c[u] = d? F(r[u]) / F(d) : F();
+  }
+}
+
+
+/**
+ * Update ranks of vertices in a CSR graph, by pulling precomputed contributions.
+ * @tparam F accumulator type
+ * @param a current rank of each vertex (output)
+ * @param xt transpose of original graph
+ * @param c rank contribution of each vertex
+ * @param C0 common teleport rank contribution to each vertex
+ * @param P damping factor [0.85]
+ * @param i begin vertex id
+ * @param I end vertex id
+ */
+template <class F, class K, class V, class E, class O, class T>
+inline void pagerankUpdateRanksCsrW(T *a, const DiGraphCsr<K, V, E, O>& xt, const F *c, T C0, T P, size_t i, size_t I) {
+  const O *offsets  = xt.offsets;
+  const K *degrees  = xt.degrees;
+  const K *edgeKeys = xt.edgeKeys;
+  for (size_t v=i; v<I; ++v) {
+    const K *ks = edgeKeys + offsets[v];
+    size_t   d  = degrees[v];
+    F s = F();
+    // Gather contributions of in-neighbors; vectorizable without reassociation flags.
+    #pragma omp simd reduction(+:s)
+    for (size_t j=0; j<d; ++j)
+      s += c[ks[j]];
+    a[v] = C0 + P * T(s);
+  }
+}
+
+
+/**
+ * Count the work of updating ranks of vertices in a CSR graph, for profiling.
+ * @param nc number of vertices that changed rank (updated)
+ * @param ne number of edges scanned (updated)
+ * @param xt transpose of original graph
+ * @param a current rank of each vertex
+ * @param r previous rank of each vertex
+ * @param i begin vertex id
+ * @param I end vertex id
+ */
+template <class K, class V, class E, class O, class T>
+inline void pagerankCountCsrU(size_t& nc, size_t& ne, const DiGraphCsr<K, V, E, O>& xt, const T *a, const T *r, size_t i, size_t I) {
+  for (size_t v=i; v<I; ++v) {
+    nc += a[v]!=r[v];
+    ne += xt.degrees[v];
+  }
+}
+
+
+#ifdef _OPENMP
+/**
+ * Partition the vertices of a CSR graph into chunks with nearly equal work (using OpenMP).
+ * @param ps chunk boundaries, as vertex ids (output)
+ * @param xt transpose of original graph
+ * @param n number of chunks
+ * @details Each vertex costs its in-degree plus one, so that runs of
+ * low-degree vertices are also split evenly.
+ */
+template <class K, class V, class E, class O>
+inline void pagerankPartitionCsrOmpW(vector<K>& ps, const DiGraphCsr<K, V, E, O>& xt, size_t n) {
+  size_t S = xt.span();
+  int    T = omp_get_max_threads();
+  vector<size_t> ws(S), buf(T);
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t u=0; u<S; ++u)
+    ws[u] = size_t(xt.degrees[u]) + 1;
+  size_t W = exclusiveScanOmpW(ws.data(), buf.data(), ws.data(), S);
+  ps.resize(n+1);
+  for (size_t j=0; j<=n; ++j) {
+    size_t w = j * W / n;
+    ps[j] = K(lower_bound(ws.begin(), ws.end(), w) - ws.begin());
+  }
+  ps[n] = K(S);
+}
+#endif
+
+
+/**
+ * Find the rank of each vertex in a static CSR graph, using a pull kernel over raw arrays.
+ * @tparam A accumulator type for contributions (void: same as rank type)
+ * @param xt transpose of original graph, with out-degree as vertex value
+ * @param o pagerank options
+ * @returns pagerank result
+ */
+template <class A=void, class K, class V, class E, class O, class T>
+inline PagerankResult<T> pagerankStaticCsr(const DiGraphCsr<K, V, E, O>& xt, const PagerankOptions<T>& o) {
+  using  F = std::conditional_t<std::is_void_v<A>, T, A>;
+  if (xt.empty()) return {};
+  size_t S = xt.span();
+  size_t N = xt.order();
+  T   P  = o.damping;
+  T   E_ = o.tolerance;
+  int L  = o.maxIterations, l = 0;
+  vector<T> r(S), a(S);
+  vector<F> c(S);
+  ProfileLog pl;  // Statistics of each iteration
+  float ti = 0, tc = 0;
+  float t  = measureDuration([&]() {
+    GVE_PROFILE_DO(pl.clear());
+    // Intitialize rank of each vertex.
+    ti += measureDuration([&]() { pagerankInitializeRanks(a, r, xt); });
+    // Compute ranks.
+    tc += measureDuration([&]() {
+      const T C0 = (1-P)/N;
+      for (l=0; l<L;) {
+        GVE_PROFILE_DO(auto t0 = timeNow());
+        pagerankContributionsCsrW(c.data(), xt, r.data(), 0, S);
+        pagerankUpdateRanksCsrW(a.data(), xt, c.data(), C0, P, 0, S); ++l;
+        GVE_PROFILE_DO(size_t nc = 0, ne = 0; pagerankCountCsrU(nc, ne, xt, a.data(), r.data(), 0, S));
+        T el = liNormDelta(a, r);  // Compare previous and current ranks
+        swap(a, r);                // Final ranks in (r)
+        GVE_PROFILE_DO(pl.record("iterate", l-1, duration(t0)); auto& pr = pl.records.back(); pr.affected = N; pr.changed = nc; pr.edges = ne; pr.imbalance = 1);
+        if (el<E_) break;          // Check tolerance
+      }
+    });
+  }, o.repeat);
+  PagerankResult<T> ans(r, l, t, ti/o.repeat, 0, tc/o.repeat);
+  ans.profile = std::move(pl);
+  return ans;
+}
+
+
+#ifdef _OPENMP
+/**
+ * Find the rank of each vertex in a static CSR graph, using a pull kernel over raw arrays (using OpenMP).
+ * @tparam A accumulator type for contributions (void: same as rank type)
+ * @tparam BALANCED partition vertices by edge count, instead of dynamic scheduling?
+ * @param xt transpose of original graph, with out-degree as vertex value
+ * @param o pagerank options
+ * @returns pagerank result
+ */
+template <class A=void, bool BALANCED=true, class K, class V, class E, class O, class T>
+inline PagerankResult<T> pagerankStaticCsrOmp(const DiGraphCsr<K, V, E, O>& xt, const PagerankOptions<T>& o) {
+  using  F = std::conditional_t<std::is_void_v<A>, T, A>;
+  const size_t CHUNK = 2048;
+  if (xt.empty()) return {};
+  size_t S = xt.span();
+  size_t N = xt.order();
+  T   P  = o.damping;
+  T   E_ = o.tolerance;
+  int L  = o.maxIterations, l = 0;
+  vector<T> r(S), a(S);
+  vector<F> c(S);
+  vector<K> ps;
+  ProfileLog pl;  // Statistics of each iteration
+  float ti = 0, tm = 0, tc = 0;
+  float t  = measureDuration([&]() {
+    GVE_PROFILE_DO(pl.clear());
+    // Intitialize rank of each vertex.
+    ti += measureDuration([&]() { pagerankInitializeRanksOmp(a, r, xt); });
+    // Partition vertices by work.
+    float dm = measureDuration([&]() {
+      if (BALANCED) pagerankPartitionCsrOmpW(ps, xt, 8 * omp_get_max_threads());
+    }); tm += dm;
+    GVE_PROFILE_DO(pl.record("partition", -1, dm, N, xt.size()));
+    // Update ranks of vertices in [i, I).
+    auto fu = [&](size_t i, size_t I, T C0) {
+      GVE_PROFILE_DO(auto t1 = timeNow());
+      pagerankUpdateRanksCsrW(a.data(), xt, c.data(), C0, P, i, I);
+      GVE_PROFILE_DO(size_t nc = 0, ne = 0; pagerankCountCsrU(nc, ne, xt, a.data(), r.data(), i, I));
+      GVE_PROFILE_DO(pl.countU(omp_get_thread_num(), I-i, nc, ne, duration(t1)));
+    };
+    // Compute ranks.
+    tc += measureDuration([&]() {
+      const T C0 = (1-P)/N;
+      for (l=0; l<L;) {
+        GVE_PROFILE_DO(auto t0 = timeNow());
+        #pragma omp parallel for schedule(static, 1)
+        for (size_t i=0; i<S; i+=CHUNK)
+          pagerankContributionsCsrW(c.data(), xt, r.data(), i, min(i+CHUNK, S));
+        if (BALANCED) {
+          size_t n = ps.size() - 1;
+          #pragma omp parallel for schedule(dynamic, 1)
+          for (size_t j=0; j<n; ++j)
+            fu(ps[j], ps[j+1], C0);
+        }
+        else {
+          #pragma omp parallel for schedule(dynamic, 1)
+          for (size_t i=0; i<S; i+=CHUNK)
+            fu(i, min(i+CHUNK, S), C0);
+        }
+        ++l;
+        T el = liNormDeltaOmp(a, r);  // Compare previous and current ranks
+        swap(a, r);                   // Final ranks in (r)
+        GVE_PROFILE_DO(pl.recordThreads("iterate", l-1, duration(t0)));
+        if (el<E_) break;             // Check tolerance
+      }
+    });
+  }, o.repeat);
+  PagerankResult<T> ans(r, l, t, ti/o.repeat, tm/o.repeat, tc/o.repeat);
+  ans.profile = std::move(pl);
+  return ans;
 }
 #endif
 #pragma endregion
@@ -450,6 +712,7 @@ inline PagerankResult<V> pagerankInvokeOmp(const H& xt, const PagerankOptions<V>
  */
 template <bool ASYNC=false, class H, class V>
 inline PagerankResult<V> pagerankStatic(const H& xt, const PagerankOptions<V>& o) {
+  if constexpr (!ASYNC && isDiGraphCsr<H>) return pagerankStaticCsr(xt, o);
   if (xt.empty()) return {};
   auto fi = [&](auto& a, auto& r) { pagerankInitializeRanks<ASYNC>(a, r, xt); };
   auto fm = [ ]() { };
@@ -468,6 +731,7 @@ inline PagerankResult<V> pagerankStatic(const H& xt, const PagerankOptions<V>& o
  */
 template <bool ASYNC=false, class H, class V>
 inline PagerankResult<V> pagerankStaticOmp(const H& xt, const PagerankOptions<V>& o) {
+  if constexpr (!ASYNC && isDiGraphCsr<H>) return pagerankStaticCsrOmp(xt, o);
   if (xt.empty()) return {};
   auto fi = [&](auto& a, auto& r) { pagerankInitializeRanksOmp<ASYNC>(a, r, xt); };
   auto fm = [ ]() { };
@@ -558,16 +822,26 @@ inline void pagerankAffectedTraversalOmpW(vector<B>& vis, const G& x, const G& y
   auto  fp = [](auto u, auto d) { };
   size_t D = deletions.size();
   size_t I = insertions.size();
-  #pragma omp parallel for schedule(auto)
-  for (size_t i=0; i<D; ++i) {
-    K u = get<0>(deletions[i]);
-    x.forEachEdgeKey(u, [&](auto v) { bfsVisitedForEachU(vis, y, v, ft, fp); });
-  }
-  #pragma omp parallel for schedule(auto)
-  for (size_t i=0; i<I; ++i) {
-    K u = get<0>(insertions[i]);
-    y.forEachEdgeKey(u, [&](auto v) { bfsVisitedForEachU(vis, y, v, ft, fp); });
+  int    T = omp_get_max_threads();
+  vector<vector<K>> qs(T);
+  vector<K> us, vs;
+  // Gather the start vertices, and run a single multi-source BFS from them.
+  #pragma omp parallel
+  {
+    int t = omp_get_thread_num();
+    #pragma omp for schedule(auto) nowait
+    for (size_t i=0; i<D; ++i) {
+      K u = get<0>(deletions[i]);
+      x.forEachEdgeKey(u, [&](auto v) { if (!vis[v]) qs[t].push_back(v); });
+    }
+    #pragma omp for schedule(auto) nowait
+    for (size_t i=0; i<I; ++i) {
+      K u = get<0>(insertions[i]);
+      y.forEachEdgeKey(u, [&](auto v) { if (!vis[v]) qs[t].push_back(v); });
+    }
   }
+  bfsMergeFrontiersOmpW(us, qs);
+  bfsVisitedForEachOmpU(vis, us, vs, y, ft, fp);
 }
 #endif
 
@@ -758,6 +1032,7 @@ EXPORT namespace gve {
   // using detail::pagerankInitializeRanks;
   // using detail::pagerankInitializeRanksFrom;
   // using detail::pagerankInvoke;
+  using detail::pagerankStaticCsr;
   using detail::pagerankStatic;
   using detail::pagerankNaiveDynamic;
   // using detail::pagerankAffectedTraversalW;
@@ -770,6 +1045,7 @@ EXPORT namespace gve {
   // using detail::pagerankInitializeRanksOmp;
   // using detail::pagerankInitializeRanksFromOmp;
   // using detail::pagerankInvokeOmp;
+  using detail::pagerankStaticCsrOmp;
   using detail::pagerankStaticOmp;
   using detail::pagerankNaiveDynamicOmp;
   // using detail::pagerankAffectedTraversalOmpW;
@@ -0,0 +1,381 @@
+// Copyright (C) 2025 Subhajit Sahu
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// See LICENSE for full terms
+#pragma once
+
+#if defined(MPI_VERSION) || defined(USE_MPI) || defined(MPI_ENABLED)
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <mpi.h>
+#include "_main.hxx"
+#include "Graph.hxx"
+#include "pagerank.hxx"
+
+
+
+
+// An internal namespace helps to hide implementation details.
+// This is particularly useful for pre-C++20 modules.
+namespace gve {
+namespace detail {
+using std::tuple;
+using std::vector;
+using std::get;
+using std::abs;
+using std::max;
+using std::min;
+
+
+
+
+#pragma region TYPES
+/**
+ * Part of a graph owned by a process, for distributed PageRank.
+ * The local vertices are the rows of a CSR of their in-edges. Each in-edge
+ * refers to a column, which is either a local vertex (same as its row), or a
+ * ghost vertex owned by another process. Local vertices with only local
+ * in-neighbors (interior) come first, and those with remote in-neighbors
+ * (boundary) come next. Ghost columns are grouped by their owner process.
+ * @tparam K key type (vertex id)
+ * @tparam O offset type
+ */
+template <class K=uint32_t, class O=size_t>
+struct PagerankMpiPartition {
+  #pragma region DATA
+  /** In-edges of local vertices, with out-degree as vertex value. */
+  DiGraphCsr<K, K, None, O> xt;
+  /** Global vertex id of each column. */
+  vector<K> keys;
+  /** Column of each global vertex id (or -1, if not seen by this process). */
+  vector<K> columns;
+  /** Rows of local vertices with an in-edge from each column. */
+  vector<O> outOffsets;
+  /** Rows of local vertices with an in-edge from each column (lookup using outOffsets). */
+  vector<K> outRows;
+  /** Number of vertices in the whole graph. */
+  size_t order = 0;
+  /** Number of local vertices with only local in-neighbors. */
+  size_t interior = 0;
+  /** Processes to exchange rank contributions with. */
+  vector<int> peers;
+  /** Local columns to send to each peer (begin offsets). */
+  vector<size_t> sendOffsets;
+  /** Local columns to send to each peer (lookup using sendOffsets). */
+  vector<K> sendColumns;
+  /** Ghost columns to receive from each peer (begin offsets). */
+  vector<size_t> recvOffsets;
+  #pragma endregion
+};
+#pragma endregion
+
+
+
+
+#pragma region METHODS
+#pragma region PARTITION
+/**
+ * Obtain the part of a graph owned by this process, for distributed PageRank.
+ * @param a part of graph owned by this process (output)
+ * @param x original graph (only out-edges of vertices owned by this process are read)
+ * @param parts process owning each vertex, e.g. from partitionById() (same on all processes)
+ * @param comm communicator
+ * @note The in-edges of boundary vertices are exchanged with MPI_Alltoallv.
+ */
+template <class K, class O, class G>
+inline void pagerankMpiPartitionW(PagerankMpiPartition<K, O>& a, const G& x, const vector<int>& parts, MPI_Comm comm=MPI_COMM_WORLD) {
+  const K NONE = K(-1);
+  const MPI_Datatype TK = mpi_data_type<K>();
+  int    p = mpi_comm_rank(comm);
+  int    P = mpi_comm_size(comm);
+  size_t S = parts.size();
+  // Find the local vertices, and the global order.
+  vector<K> us;
+  for (size_t u=0; u<S; ++u)
+    if (parts[u]==p && x.hasVertex(K(u))) us.push_back(K(u));
+  uint64_t NL = us.size(), N = 0;
+  GVE_TRY_MPI(MPI_Allreduce(&NL, &N, 1, MPI_UINT64_T, MPI_SUM, comm));
+  // Send the edges to remote vertices to their owners.
+  vector<int> scounts(P), rcounts(P), soffsets(P+1), roffsets(P+1);
+  for (K u : us)
+    x.forEachEdgeKey(u, [&](auto v) { if (parts[v]!=p) scounts[parts[v]] += 2; });
+  GVE_TRY_MPI(MPI_Alltoall(scounts.data(), 1, MPI_INT, rcounts.data(), 1, MPI_INT, comm));
+  for (int q=0; q<P; ++q) {
+    soffsets[q+1] = soffsets[q] + scounts[q];
+    roffsets[q+1] = roffsets[q] + rcounts[q];
+  }
+  vector<K> sedges(soffsets[P]), redges(roffsets[P]);
+  vector<int> sfill(soffsets.begin(), soffsets.end()-1);
+  for (K u : us)
+    x.forEachEdgeKey(u, [&](auto v) {
+      if (parts[v]==p) return;
+      int& i = sfill[parts[v]];
+      sedges[i++] = u;
+      sedges[i++] = K(v);
+    });
+  GVE_TRY_MPI(MPI_Alltoallv(sedges.data(), scounts.data(), soffsets.data(), TK, redges.data(), rcounts.data(), roffsets.data(), TK, comm));
+  // Place interior vertices first, and then boundary vertices.
+  vector<char> isBoundary(S);
+  for (size_t i=1; i<redges.size(); i+=2)
+    isBoundary[redges[i]] = 1;
+  auto ib = std::stable_partition(us.begin(), us.end(), [&](K u) { return !isBoundary[u]; });
+  a.order    = N;
+  a.interior = ib - us.begin();
+  a.keys     = us;
+  a.columns.assign(S, NONE);
+  for (size_t j=0; j<NL; ++j)
+    a.columns[us[j]] = K(j);
+  // Add ghost columns, grouped by owner, in order of vertex id.
+  a.peers.clear();
+  a.sendColumns.clear();
+  a.sendOffsets.assign(1, 0);
+  a.recvOffsets.assign(1, NL);
+  vector<K> vs;
+  for (int q=0; q<P; ++q) {
+    if (scounts[q]==0 && rcounts[q]==0) continue;
+    vs.clear();
+    for (int i=roffsets[q]; i<roffsets[q+1]; i+=2)
+      vs.push_back(redges[i]);
+    std::sort(vs.begin(), vs.end());
+    vs.erase(std::unique(vs.begin(), vs.end()), vs.end());
+    for (K u : vs) {
+      a.columns[u] = K(a.keys.size());
+      a.keys.push_back(u);
+    }
+    vs.clear();
+    for (int i=soffsets[q]; i<soffsets[q+1]; i+=2)
+      vs.push_back(sedges[i]);
+    std::sort(vs.begin(), vs.end());
+    vs.erase(std::unique(vs.begin(), vs.end()), vs.end());
+    for (K u : vs)
+      a.sendColumns.push_back(a.columns[u]);
+    a.peers.push_back(q);
+    a.sendOffsets.push_back(a.sendColumns.size());
+    a.recvOffsets.push_back(a.keys.size());
+  }
+  // Build the in-edges of local vertices, as columns.
+  size_t NC = a.keys.size();
+  size_t M  = 0;
+  for (K u : us)
+    x.forEachEdgeKey(u, [&](auto v) { if (parts[v]==p) ++M; });
+  M += redges.size() / 2;
+  auto& xt = a.xt;
+  xt.resize(NL, M);
+  fillValueU(xt.degrees, NL, K());
+  auto fe = [&](auto fp) {
+    for (K u : us)
+      x.forEachEdgeKey(u, [&](auto v) { if (parts[v]==p) fp(a.columns[u], a.columns[v]); });
+    for (size_t i=0; i<redges.size(); i+=2)
+      fp(a.columns[redges[i]], a.columns[redges[i+1]]);
+  };
+  fe([&](K j, K v) { ++xt.degrees[v]; });
+  xt.offsets[0] = O();
+  exclusiveScanW(xt.offsets+1, xt.degrees, NL);
+  fe([&](K j, K v) { xt.edgeKeys[xt.offsets[v+1]++] = j; });
+  for (size_t v=0; v<NL; ++v) {
+    xt.values[v] = K(x.degree(us[v]));
+    std::sort(xt.edgeKeys + xt.offsets[v], xt.edgeKeys + xt.offsets[v+1]);
+  }
+  // Find the out-edges of each column, to local vertices.
+  a.outOffsets.assign(NC+1, O());
+  a.outRows.resize(M);
+  for (size_t i=0; i<M; ++i)
+    ++a.outOffsets[xt.edgeKeys[i]+1];
+  for (size_t j=0; j<NC; ++j)
+    a.outOffsets[j+1] += a.outOffsets[j];
+  vector<O> ofill(a.outOffsets.begin(), a.outOffsets.end()-1);
+  for (size_t v=0; v<NL; ++v)
+    xt.forEachEdgeKey(K(v), [&](auto j) { a.outRows[ofill[j]++] = K(v); });
+}
+#pragma endregion
+
+
+
+
+#pragma region ENVIRONMENT SETUP
+/**
+ * Setup and perform the PageRank algorithm, on the part of a graph owned by this process.
+ * In each iteration, the contributions of boundary columns are exchanged with
+ * nonblocking sends, while the ranks of interior vertices are updated.
+ * @tparam DYNAMIC update only affected vertices, expanding them as ranks change?
+ * @param xp part of graph owned by this process
+ * @param o pagerank options
+ * @param fi initializing rank of each local vertex (a, r)
+ * @param fm marking affected local vertices (vaff)
+ * @param comm communicator
+ * @returns pagerank result, with ranks of local vertices (others are zero)
+ */
+template <bool DYNAMIC=false, class K, class O, class V, class FI, class FM>
+inline PagerankResult<V> pagerankInvokeMpi(const PagerankMpiPartition<K, O>& xp, const PagerankOptions<V>& o, FI fi, FM fm, MPI_Comm comm) {
+  const MPI_Datatype TV = mpi_data_type<V>();
+  const auto& xt = xp.xt;
+  size_t S  = xp.columns.size();
+  size_t N  = xp.order;
+  size_t NL = xt.span();
+  size_t NI = xp.interior;
+  size_t NC = xp.keys.size();
+  size_t NP = xp.peers.size();
+  V   P  = o.damping;
+  V   E  = o.tolerance;
+  V   D  = o.frontierTolerance;
+  int L  = o.maxIterations, l = 0;
+  if (N==0) return {};
+  vector<V> r(NL), a(NL), c(NC), cp, sbuf(xp.sendColumns.size());
+  vector<char> vaff;
+  vector<MPI_Request> reqs(2*NP);
+  if (DYNAMIC) { cp.resize(NC); vaff.resize(NL); }
+  // Mark local vertices with an in-edge from columns whose contribution has changed.
+  auto fc = [&](size_t j, size_t J) {
+    for (; j<J; ++j) {
+      V cj = c[j], pj = cp[j]; cp[j] = cj;
+      if (l==0 || abs(cj - pj) <= D * max(cj, pj)) continue;
+      for (O i=xp.outOffsets[j]; i<xp.outOffsets[j+1]; ++i)
+        vaff[xp.outRows[i]] = 1;
+    }
+  };
+  // Update ranks of local vertices.
+  auto fu = [&](const V C0, size_t v, size_t V1) {
+    if (!DYNAMIC) { pagerankUpdateRanksCsrW(a.data(), xt, c.data(), C0, P, v, V1); return; }
+    for (; v<V1; ++v)
+      if (vaff[v]) pagerankUpdateRanksCsrW(a.data(), xt, c.data(), C0, P, v, v+1);
+  };
+  float ti = 0, tm = 0, tc = 0;
+  float t  = measureDurationMpi([&]() {
+    // Intitialize rank of each vertex.
+    ti += measureDuration([&]() { fi(a, r); });
+    // Mark affected vertices.
+    tm += measureDuration([&]() { if (DYNAMIC) { fillValueU(vaff, char()); fm(vaff); } });
+    // Compute ranks.
+    tc += measureDuration([&]() {
+      const V C0 = (1-P)/N;
+      for (l=0; l<L;) {
+        // Send contributions of boundary columns, and receive those of ghost columns.
+        pagerankContributionsCsrW(c.data(), xt, r.data(), 0, NL);
+        for (size_t i=0; i<sbuf.size(); ++i)
+          sbuf[i] = c[xp.sendColumns[i]];
+        for (size_t i=0; i<NP; ++i) {
+          size_t rb = xp.recvOffsets[i], re = xp.recvOffsets[i+1];
+          size_t sb = xp.sendOffsets[i], se = xp.sendOffsets[i+1];
+          GVE_TRY_MPI(MPI_Irecv(c.data() + rb, int(re-rb), TV, xp.peers[i], 0, comm, &reqs[2*i]));
+          GVE_TRY_MPI(MPI_Isend(sbuf.data() + sb, int(se-sb), TV, xp.peers[i], 0, comm, &reqs[2*i+1]));
+        }
+        // Update interior vertices, while contributions are in flight.
+        if (DYNAMIC) fc(0, NL);
+        fu(C0, 0, NI);
+        // Update boundary vertices.
+        GVE_TRY_MPI(MPI_Waitall(int(reqs.size()), reqs.data(), MPI_STATUSES_IGNORE));
+        if (DYNAMIC) fc(NL, NC);
+        fu(C0, NI, NL); ++l;
+        // Compare previous and current ranks, across processes.
+        V el = liNormDelta(a, r), EL = V();
+        GVE_TRY_MPI(MPI_Allreduce(&el, &EL, 1, TV, MPI_MAX, comm));
+        swap(a, r);       // Final ranks in (r)
+        if (EL<E) break;  // Check tolerance
+      }
+    });
+  }, o.repeat);
+  vector<V> ranks(S);
+  for (size_t j=0; j<NL; ++j)
+    ranks[xp.keys[j]] = r[j];
+  return {ranks, l, t, ti/o.repeat, tm/o.repeat, tc/o.repeat};
+}
+#pragma endregion
+
+
+
+
+#pragma region STATIC
+/**
+ * Find the rank of each vertex in a static graph, across processes.
+ * @param xp part of graph owned by this process, from pagerankMpiPartitionW()
+ * @param o pagerank options
+ * @param comm communicator
+ * @returns pagerank result, with ranks of vertices owned by this process (others are zero)
+ * @note Sum the ranks across processes (e.g. with MPI_Reduce) to obtain all ranks.
+ */
+template <class K, class O, class V>
+inline PagerankResult<V> pagerankStaticMpi(const PagerankMpiPartition<K, O>& xp, const PagerankOptions<V>& o, MPI_Comm comm=MPI_COMM_WORLD) {
+  size_t N = xp.order;
+  auto fi = [&](auto& a, auto& r) {
+    fillValueU(r, V(1)/N);
+    fillValueU(a, V(1)/N);
+  };
+  auto fm = [&](auto& vaff) {};
+  return pagerankInvokeMpi<false>(xp, o, fi, fm, comm);
+}
+#pragma endregion
+
+
+
+
+#pragma region DYNAMIC FRONTIER
+/**
+ * Find affected local vertices due to a batch update with Dynamic Frontier approach.
+ * @param vaff affected flags (output)
+ * @param yp part of updated graph owned by this process
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ */
+template <class B, class K, class O>
+inline void pagerankAffectedFrontierMpiW(vector<B>& vaff, const PagerankMpiPartition<K, O>& yp, const vector<tuple<K, K>>& deletions, const vector<tuple<K, K>>& insertions) {
+  const K NONE = K(-1);
+  size_t NL = yp.xt.span();
+  auto fo = [&](K u) {
+    K j = u<yp.columns.size()? yp.columns[u] : NONE;
+    if (j==NONE) return;
+    for (O i=yp.outOffsets[j]; i<yp.outOffsets[j+1]; ++i)
+      vaff[yp.outRows[i]] = B(1);
+  };
+  for (const auto& [u, v] : deletions) {
+    K j = v<yp.columns.size()? yp.columns[v] : NONE;
+    if (j!=NONE && j<NL) vaff[j] = B(1);
+    fo(u);
+  }
+  for (const auto& [u, v] : insertions)
+    fo(u);
+}
+
+
+/**
+ * Find the rank of each vertex in a dynamic graph with Dynamic Frontier approach, across processes.
+ * @param yp part of updated graph owned by this process, from pagerankMpiPartitionW()
+ * @param deletions edge deletions in batch update (same on all processes)
+ * @param insertions edge insertions in batch update (same on all processes)
+ * @param q initial ranks (only those of vertices owned by this process are read)
+ * @param o pagerank options
+ * @param comm communicator
+ * @returns pagerank result, with ranks of vertices owned by this process (others are zero)
+ * @note Affected vertices stay affected. A process learns that a remote
+ * in-neighbor has changed from its exchanged contribution, so no extra
+ * messages are needed to expand the frontier.
+ */
+template <class K, class O, class V>
+inline PagerankResult<V> pagerankDynamicFrontierMpi(const PagerankMpiPartition<K, O>& yp, const vector<tuple<K, K>>& deletions, const vector<tuple<K, K>>& insertions, const vector<V> *q, const PagerankOptions<V>& o, MPI_Comm comm=MPI_COMM_WORLD) {
+  size_t NL = yp.xt.span();
+  auto fi = [&](auto& a, auto& r) {
+    for (size_t j=0; j<NL; ++j)
+      r[j] = a[j] = (*q)[yp.keys[j]];
+  };
+  auto fm = [&](auto& vaff) { pagerankAffectedFrontierMpiW(vaff, yp, deletions, insertions); };
+  return pagerankInvokeMpi<true>(yp, o, fi, fm, comm);
+}
+#pragma endregion
+#pragma endregion
+} // namespace detail
+} // namespace gve
+
+
+
+
+// Now, we export the public API.
+EXPORT namespace gve {
+  // Types
+  using detail::PagerankMpiPartition;
+  // Methods
+  using detail::pagerankMpiPartitionW;
+  using detail::pagerankStaticMpi;
+  using detail::pagerankDynamicFrontierMpi;
+} // namespace gve
+#endif
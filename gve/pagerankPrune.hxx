@@ -124,22 +124,29 @@ inline V pagerankPruneUpdateRanksAsync(vector<V>& a, vector<B>& vafe, const G& x
  * @param P damping factor [0.85]
  * @param D frontier tolerance
  * @param C prune tolerance
+ * @param pl profile log (optional)
  */
 template <bool ASYNCF=false, class G, class H, class V, class B>
-inline void pagerankPruneUpdateRanksOmp(vector<V>& a, vector<B>& vafe, const G& x, const H& xt, const vector<V>& r, const vector<B>& vaff, V C0, V P, V D, V C) {
+inline void pagerankPruneUpdateRanksOmp(vector<V>& a, vector<B>& vafe, const G& x, const H& xt, const vector<V>& r, const vector<B>& vaff, V C0, V P, V D, V C, ProfileLog *pl=nullptr) {
   using  K = typename H::key_type;
   size_t S = xt.span();
-  #pragma omp parallel for schedule(dynamic, 2048)
-  for (K u=0; u<S; ++u) {
-    if (!xt.hasVertex(u)) continue;
-    if (!vaff[u]) { a[u] = r[u]; continue; }
-    V ru = pagerankPruneUpdateRank(a, xt, r, u, C0, P);
-    const auto au = a[u];
-    const auto eu = abs(ru - au);
-    if (!ASYNCF) { if (eu > C) vafe[u] = B(1); }
-    else         { if (eu/max(ru, au) <= C) vafe[u] = B(0); }
-    if (eu/max(ru, au) <= D) continue;
-    x.forEachEdgeKey(u, [&](auto v) { if (v!=u && !vafe[v]) vafe[v] = B(1); });
+  #pragma omp parallel
+  {
+    GVE_PROFILE_DO(auto t1 = timeNow(); size_t na = 0, nc = 0, ne = 0);
+    #pragma omp for schedule(dynamic, 2048) nowait
+    for (K u=0; u<S; ++u) {
+      if (!xt.hasVertex(u)) continue;
+      if (!vaff[u]) { a[u] = r[u]; continue; }
+      V ru = pagerankPruneUpdateRank(a, xt, r, u, C0, P);
+      const auto au = a[u];
+      const auto eu = abs(ru - au);
+      GVE_PROFILE_DO(++na; nc += ru!=au; ne += xt.degree(u));
+      if (!ASYNCF) { if (eu > C) vafe[u] = B(1); }
+      else         { if (eu/max(ru, au) <= C) vafe[u] = B(0); }
+      if (eu/max(ru, au) <= D) continue;
+      x.forEachEdgeKey(u, [&](auto v) { if (v!=u && !vafe[v]) vafe[v] = B(1); });
+    }
+    GVE_PROFILE_DO(if (pl) pl->countU(omp_get_thread_num(), na, nc, ne, duration(t1)));
   }
 }
 
@@ -155,24 +162,31 @@ inline void pagerankPruneUpdateRanksOmp(vector<V>& a, vector<B>& vafe, const G&
  * @param P damping factor [0.85]
  * @param D frontier tolerance
  * @param C prune tolerance
+ * @param pl profile log (optional)
  */
 template <bool ASYNCF=false, class G, class H, class V, class B>
-inline V pagerankPruneUpdateRanksAsyncOmp(vector<V>& a, vector<B>& vafe, const G& x, const H& xt, const vector<B>& vaff, V C0, V P, V D, V C) {
+inline V pagerankPruneUpdateRanksAsyncOmp(vector<V>& a, vector<B>& vafe, const G& x, const H& xt, const vector<B>& vaff, V C0, V P, V D, V C, ProfileLog *pl=nullptr) {
   using  K = typename H::key_type;
   size_t S = xt.span();
   V el = V();
-  #pragma omp parallel for schedule(dynamic, 2048) reduction(max:el)
-  for (K u=0; u<S; ++u) {
-    if (!xt.hasVertex(u)) continue;
-    if (!vaff[u]) continue;
-    V ru = pagerankPruneUpdateRank(a, xt, a, u, C0, P);
-    const auto au = a[u];
-    const auto eu = abs(ru - au);
-    el = max(el, eu);
-    if (!ASYNCF) { if (eu > C) vafe[u] = B(1); }
-    else         { if (eu/max(ru, au) <= C) vafe[u] = B(0); }
-    if (eu/max(ru, au) <= D) continue;
-    x.forEachEdgeKey(u, [&](auto v) { if (v!=u && !vafe[v]) vafe[v] = B(1); });
+  #pragma omp parallel reduction(max:el)
+  {
+    GVE_PROFILE_DO(auto t1 = timeNow(); size_t na = 0, nc = 0, ne = 0);
+    #pragma omp for schedule(dynamic, 2048) nowait
+    for (K u=0; u<S; ++u) {
+      if (!xt.hasVertex(u)) continue;
+      if (!vaff[u]) continue;
+      V ru = pagerankPruneUpdateRank(a, xt, a, u, C0, P);
+      const auto au = a[u];
+      const auto eu = abs(ru - au);
+      el = max(el, eu);
+      GVE_PROFILE_DO(++na; nc += ru!=au; ne += xt.degree(u));
+      if (!ASYNCF) { if (eu > C) vafe[u] = B(1); }
+      else         { if (eu/max(ru, au) <= C) vafe[u] = B(0); }
+      if (eu/max(ru, au) <= D) continue;
+      x.forEachEdgeKey(u, [&](auto v) { if (v!=u && !vafe[v]) vafe[v] = B(1); });
+    }
+    GVE_PROFILE_DO(if (pl) pl->countU(omp_get_thread_num(), na, nc, ne, duration(t1)));
   }
   return el;
 }
@@ -262,34 +276,42 @@ inline PagerankResult<V> pagerankPruneInvokeOmp(const G& x, const H& xt, const P
   vector<B> vaff(S), vafe;
   if (!ASYNC)  a.resize(S);
   if (!ASYNCF) vafe.resize(S);
+  ProfileLog pl;  // Statistics of each iteration
   float ti = 0, tm = 0, tc = 0;
   float t  = measureDuration([&]() {
+    GVE_PROFILE_DO(pl.clear());
     // Initialize rank of each vertex.
     ti += measureDuration([&]() { fi(a, r); });
     // Mark affected vertices.
-    tm += measureDuration([&]() { fm(vaff); });
+    float dm = measureDuration([&]() { fm(vaff); }); tm += dm;
+    GVE_PROFILE_DO(pl.record("mark", -1, dm, xt.order(), xt.size()); pl.records.back().affected = countValueOmp(vaff, B(1)));
     // Compute ranks.
     tc += measureDuration([&]() {
       const V C0 = (1-P)/S;
       for (l=0; l<L;) {
+        GVE_PROFILE_DO(auto t0 = timeNow());
         if (ASYNC) {
           if (!ASYNCF) fillValueOmpU(vafe, B(0));  // Reset affected vertices for next iteration
-          V el = pagerankPruneUpdateRanksAsyncOmp<ASYNCF>(r, ASYNCF? vaff : vafe, x, xt, vaff, C0, P, D, C); ++l;  // Update ranks of vertices
+          V el = pagerankPruneUpdateRanksAsyncOmp<ASYNCF>(r, ASYNCF? vaff : vafe, x, xt, vaff, C0, P, D, C, &pl); ++l;  // Update ranks of vertices
           if (!ASYNCF) swap(vafe, vaff);  // Affected vertices in (vaff)
+          GVE_PROFILE_DO(pl.recordThreads("iterate", l-1, duration(t0)));
           if (el<E) break;   // Check tolerance
         }
         else {
           if (!ASYNCF) fillValueOmpU(vafe, B(0));  // Reset affected vertices for next iteration
-          pagerankPruneUpdateRanksOmp<ASYNCF>(a, ASYNCF? vaff : vafe, x, xt, r, vaff, C0, P, D, C); ++l;  // Update ranks of vertices
+          pagerankPruneUpdateRanksOmp<ASYNCF>(a, ASYNCF? vaff : vafe, x, xt, r, vaff, C0, P, D, C, &pl); ++l;  // Update ranks of vertices
           V el = liNormDeltaOmp(a, r);  // Compare previous and current ranks
           if (!ASYNCF) swap(vafe, vaff);  // Affected vertices in (vaff)
           swap(a, r);        // Final ranks in (r)
+          GVE_PROFILE_DO(pl.recordThreads("iterate", l-1, duration(t0)));
           if (el<E) break;   // Check tolerance
         }
       }
     });
   }, o.repeat);
-  return {r, l, t, ti/o.repeat, tm/o.repeat, tc/o.repeat};
+  PagerankResult<V> ans(r, l, t, ti/o.repeat, tm/o.repeat, tc/o.repeat);
+  ans.profile = std::move(pl);
+  return ans;
 }
 #endif
 #pragma endregion
@@ -9,6 +9,7 @@
 #include "_main.hxx"
 #include "bfs.hxx"
 #include "dfs.hxx"
+#include "components.hxx"
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -379,35 +380,53 @@ inline vector<K> communities(const G& x, const vector<K>& vcom) {
 
 
 #pragma region DISCONNECTED COMMUNITIES
-#ifdef _OPENMP
 /**
- * Examine if each community in a graph is disconnected (using single flag vector, BFS).
+ * Examine if each community in a graph is disconnected (using union-find).
+ * Each community must be a single component over its internal edges.
  * @param x given graph
  * @param vcom community each vertex belongs to
  * @returns whether each community is disconnected
  */
 template <class G, class K>
+inline vector<char> communitiesDisconnected(const G& x, const vector<K>& vcom) {
+  size_t S = x.span();
+  auto  fe = [&](auto u, auto v) { return vcom[u]==vcom[v]; };
+  auto comp = components(x, fe);
+  vector<K> roots(S);
+  vector<char> a(S);
+  x.forEachVertexKey([&](auto u) {
+    if (comp[u]==u) ++roots[vcom[u]];
+  });
+  for (K c=0; c<S; ++c)
+    a[c] = roots[c] > 1;
+  return a;
+}
+
+
+#ifdef _OPENMP
+/**
+ * Examine if each community in a graph is disconnected (using Afforest union-find).
+ * Each community must be a single component over its internal edges.
+ * @param x given graph (symmetric)
+ * @param vcom community each vertex belongs to
+ * @returns whether each community is disconnected
+ */
+template <class G, class K>
 inline vector<char> communitiesDisconnectedOmp(const G& x, const vector<K>& vcom) {
-  size_t  S = x.span();
-  int     T = omp_get_max_threads();
-  auto coms = communitySizeOmp(x, vcom);
-  vector<char> a(S), vis(S);
-  vector2d<K>  us (T), vs(T);
-  #pragma omp parallel
-  {
-    for (K u=0; u<S; ++u) {
-      if (!x.hasVertex(u)) continue;
-      int t = omp_get_thread_num();
-      K   c = vcom[u], reached = K();
-      if (coms[c]==0 || !belongsOmp(c)) continue;
-      auto ft = [&](auto v, auto d) { return vcom[v]==c; };
-      auto fp = [&](auto v, auto d) { ++reached; };
-      us[t].clear(); vs[t].clear(); us[t].push_back(u);
-      bfsVisitedForEachU(vis, us[t], vs[t], x, ft, fp);
-      if (reached < coms[c]) a[c] = 1;
-      coms[c] = 0;
-    }
+  size_t S = x.span();
+  auto  fe = [&](auto u, auto v) { return vcom[u]==vcom[v]; };
+  auto comp = componentsOmp<true>(x, fe);
+  vector<K> roots(S);
+  vector<char> a(S);
+  #pragma omp parallel for schedule(static, 2048)
+  for (K u=0; u<S; ++u) {
+    if (!x.hasVertex(u) || comp[u]!=u) continue;
+    #pragma omp atomic
+    ++roots[vcom[u]];
   }
+  #pragma omp parallel for schedule(static, 2048)
+  for (K c=0; c<S; ++c)
+    a[c] = roots[c] > 1;
   return a;
 }
 #endif
@@ -433,6 +452,7 @@ EXPORT namespace gve {
   using detail::communitySize;
   using detail::communityVertices;
   using detail::communities;
+  using detail::communitiesDisconnected;
 #ifdef _OPENMP
   using detail::edgeWeightOmp;
   using detail::modularityCommunitiesOmp;
@@ -0,0 +1,520 @@
+// Copyright (C) 2025 Subhajit Sahu
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// See LICENSE for full terms
+#pragma once
+
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include "_main.hxx"
+#include "Graph.hxx"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+
+
+// An internal namespace helps to hide implementation details.
+// This is particularly useful for pre-C++20 modules.
+namespace gve {
+namespace detail {
+using std::pair;
+using std::vector;
+using std::sort;
+using std::reverse;
+using std::min;
+
+
+
+
+#pragma region METHODS
+#pragma region HELPERS
+/**
+ * Obtain the keys of vertices in the graph.
+ * @param a vertex keys (output)
+ * @param x original graph
+ */
+template <class G, class K>
+inline void reorderVertexKeysW(vector<K>& a, const G& x) {
+  a.clear();
+  a.reserve(x.order());
+  x.forEachVertexKey([&](auto u) { a.push_back(u); });
+}
+#pragma endregion
+
+
+
+
+#pragma region MAP
+/**
+ * Obtain the new id of each vertex, from the vertices in new order.
+ * @param a new id of each vertex, or -1 if not present (output)
+ * @param ks vertex keys in new order
+ */
+template <class K>
+inline void reorderMapW(vector<K>& a, const vector<K>& ks) {
+  size_t N = ks.size();
+  fillValueU(a, K(-1));
+  for (size_t i=0; i<N; ++i)
+    a[ks[i]] = K(i);
+}
+
+
+/**
+ * Map values indexed by new vertex ids back to the original vertex ids.
+ * @param a values indexed by original vertex ids (output)
+ * @param x values indexed by new vertex ids
+ * @param ks vertex keys in new order
+ */
+template <class T, class K>
+inline void reorderValuesW(vector<T>& a, const vector<T>& x, const vector<K>& ks) {
+  size_t N = ks.size();
+  for (size_t i=0; i<N; ++i)
+    a[ks[i]] = x[i];
+}
+
+
+#ifdef _OPENMP
+/**
+ * Obtain the new id of each vertex, from the vertices in new order (using OpenMP).
+ * @param a new id of each vertex, or -1 if not present (output)
+ * @param ks vertex keys in new order
+ */
+template <class K>
+inline void reorderMapOmpW(vector<K>& a, const vector<K>& ks) {
+  size_t N = ks.size();
+  fillValueOmpU(a, K(-1));
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t i=0; i<N; ++i)
+    a[ks[i]] = K(i);
+}
+
+
+/**
+ * Map values indexed by new vertex ids back to the original vertex ids (using OpenMP).
+ * @param a values indexed by original vertex ids (output)
+ * @param x values indexed by new vertex ids
+ * @param ks vertex keys in new order
+ */
+template <class T, class K>
+inline void reorderValuesOmpW(vector<T>& a, const vector<T>& x, const vector<K>& ks) {
+  size_t N = ks.size();
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t i=0; i<N; ++i)
+    a[ks[i]] = x[i];
+}
+#endif
+#pragma endregion
+
+
+
+
+#pragma region DEGREE ORDER
+/**
+ * Order vertices by decreasing degree (ties broken by vertex id).
+ * @param a vertex keys in new order (output)
+ * @param x original graph
+ */
+template <class G, class K>
+inline void reorderByDegreeW(vector<K>& a, const G& x) {
+  auto fl = [&](K u, K v) { auto du = x.degree(u), dv = x.degree(v); return du > dv || (du == dv && u < v); };
+  reorderVertexKeysW(a, x);
+  sort(a.begin(), a.end(), fl);
+}
+
+
+/**
+ * Order vertices by decreasing degree (ties broken by vertex id).
+ * @param x original graph
+ * @returns vertex keys in new order
+ */
+template <class G>
+inline auto reorderByDegree(const G& x) {
+  using K = typename G::key_type;
+  vector<K> a; reorderByDegreeW(a, x);
+  return a;
+}
+
+
+#ifdef _OPENMP
+/**
+ * Order vertices by decreasing degree (ties broken by vertex id) (using OpenMP).
+ * @param a vertex keys in new order (output)
+ * @param x original graph
+ */
+template <class G, class K>
+inline void reorderByDegreeOmpW(vector<K>& a, const G& x) {
+  auto fl = [&](K u, K v) { auto du = x.degree(u), dv = x.degree(v); return du > dv || (du == dv && u < v); };
+  reorderVertexKeysW(a, x);
+  sortValuesOmpU(a, fl);
+}
+
+
+/**
+ * Order vertices by decreasing degree (ties broken by vertex id) (using OpenMP).
+ * @param x original graph
+ * @returns vertex keys in new order
+ */
+template <class G>
+inline auto reorderByDegreeOmp(const G& x) {
+  using K = typename G::key_type;
+  vector<K> a; reorderByDegreeOmpW(a, x);
+  return a;
+}
+#endif
+#pragma endregion
+
+
+
+
+#pragma region RCM ORDER
+/**
+ * Order vertices with Reverse Cuthill-McKee (RCM), using BFS along out-edges.
+ * @param a vertex keys in new order (output)
+ * @param x original graph (symmetric)
+ * @note Each component is started at its minimum degree vertex, and the
+ * unvisited neighbors of a vertex are appended in increasing degree order.
+ */
+template <class G, class K>
+inline void reorderByRcmW(vector<K>& a, const G& x) {
+  auto fl = [&](K u, K v) { auto du = x.degree(u), dv = x.degree(v); return du < dv || (du == dv && u < v); };
+  vector<K> ss, vs;
+  vector<char> vis(x.span());
+  reorderVertexKeysW(ss, x);
+  sort(ss.begin(), ss.end(), fl);
+  a.clear();
+  a.reserve(ss.size());
+  for (K s : ss) {
+    if (vis[s]) continue;
+    vis[s] = 1;
+    a.push_back(s);
+    for (size_t i=a.size()-1; i<a.size(); ++i) {
+      vs.clear();
+      x.forEachEdgeKey(a[i], [&](K v) {
+        if (vis[v]) return;
+        vis[v] = 1;
+        vs.push_back(v);
+      });
+      sort(vs.begin(), vs.end(), fl);
+      a.insert(a.end(), vs.begin(), vs.end());
+    }
+  }
+  reverse(a.begin(), a.end());
+}
+
+
+/**
+ * Order vertices with Reverse Cuthill-McKee (RCM), using BFS along out-edges.
+ * @param x original graph (symmetric)
+ * @returns vertex keys in new order
+ */
+template <class G>
+inline auto reorderByRcm(const G& x) {
+  using K = typename G::key_type;
+  vector<K> a; reorderByRcmW(a, x);
+  return a;
+}
+
+
+#ifdef _OPENMP
+/**
+ * Order vertices with Reverse Cuthill-McKee (RCM), using BFS along out-edges (using OpenMP).
+ * @param a vertex keys in new order (output)
+ * @param x original graph (symmetric)
+ * @note Gives the same order as reorderByRcmW(). Each large BFS level is expanded
+ * in parallel, with every new vertex taking its earliest ordered parent, and
+ * then sorted by (parent position, degree, vertex id).
+ */
+template <class G, class K>
+inline void reorderByRcmOmpW(vector<K>& a, const G& x) {
+  const size_t SERIAL = 1024;  // Levels smaller than this are expanded serially
+  auto fl = [&](K u, K v) { auto du = x.degree(u), dv = x.degree(v); return du < dv || (du == dv && u < v); };
+  auto fv = [ ](const auto& p, const auto& q) { return p.second < q.second || (p.second == q.second && p.first < q.first); };
+  auto fp = [&](const auto& p, const auto& q) { return p.first < q.first || (p.first == q.first && fl(p.second, q.second)); };
+  int  T  = omp_get_max_threads();
+  vector<K> ss, vs;
+  vector<char> vis(x.span());
+  vector<vector<pair<size_t, K>>> qs(T);
+  vector<pair<size_t, K>> cs;
+  reorderVertexKeysW(ss, x);
+  sortValuesOmpU(ss, fl);
+  a.clear();
+  a.reserve(ss.size());
+  for (K s : ss) {
+    if (vis[s]) continue;
+    vis[s] = 1;
+    a.push_back(s);
+    for (size_t ib=a.size()-1, ie=a.size(); ib<ie; ib=ie, ie=a.size()) {
+      if (ie-ib < SERIAL) {
+        for (size_t i=ib; i<ie; ++i) {
+          vs.clear();
+          x.forEachEdgeKey(a[i], [&](K v) {
+            if (vis[v]) return;
+            vis[v] = 1;
+            vs.push_back(v);
+          });
+          sort(vs.begin(), vs.end(), fl);
+          a.insert(a.end(), vs.begin(), vs.end());
+        }
+        continue;
+      }
+      // Find (parent position, vertex) of each unvisited neighbor.
+      #pragma omp parallel
+      {
+        int t = omp_get_thread_num();
+        qs[t].clear();
+        #pragma omp for schedule(dynamic, 64) nowait
+        for (size_t i=ib; i<ie; ++i)
+          x.forEachEdgeKey(a[i], [&](K v) { if (!vis[v]) qs[t].push_back({i, v}); });
+      }
+      cs.clear();
+      for (int t=0; t<T; ++t)
+        cs.insert(cs.end(), qs[t].begin(), qs[t].end());
+      // Keep the earliest parent of each vertex, and order by it.
+      sortValuesOmpU(cs, fv);
+      auto fe = [](const auto& p, const auto& q) { return p.second == q.second; };
+      cs.erase(std::unique(cs.begin(), cs.end(), fe), cs.end());
+      sortValuesOmpU(cs, fp);
+      size_t C = cs.size(), A = a.size();
+      a.resize(A + C);
+      #pragma omp parallel for schedule(static, 2048)
+      for (size_t i=0; i<C; ++i) {
+        vis[cs[i].second] = 1;
+        a[A+i] = cs[i].second;
+      }
+    }
+  }
+  reverse(a.begin(), a.end());
+}
+
+
+/**
+ * Order vertices with Reverse Cuthill-McKee (RCM), using BFS along out-edges (using OpenMP).
+ * @param x original graph (symmetric)
+ * @returns vertex keys in new order
+ */
+template <class G>
+inline auto reorderByRcmOmp(const G& x) {
+  using K = typename G::key_type;
+  vector<K> a; reorderByRcmOmpW(a, x);
+  return a;
+}
+#endif
+#pragma endregion
+
+
+
+
+#pragma region COMMUNITY ORDER
+/**
+ * Order vertices by community, so that members of a community are contiguous.
+ * @param a vertex keys in new order (output)
+ * @param x original graph
+ * @param vcom community each vertex belongs to (e.g., membership from leidenStaticOmp)
+ */
+template <class G, class K>
+inline void reorderByCommunityW(vector<K>& a, const G& x, const vector<K>& vcom) {
+  auto fl = [&](K u, K v) { return vcom[u] < vcom[v] || (vcom[u] == vcom[v] && u < v); };
+  reorderVertexKeysW(a, x);
+  sort(a.begin(), a.end(), fl);
+}
+
+
+/**
+ * Order vertices by community, so that members of a community are contiguous.
+ * @param x original graph
+ * @param vcom community each vertex belongs to (e.g., membership from leidenStaticOmp)
+ * @returns vertex keys in new order
+ */
+template <class G, class K>
+inline auto reorderByCommunity(const G& x, const vector<K>& vcom) {
+  vector<K> a; reorderByCommunityW(a, x, vcom);
+  return a;
+}
+
+
+#ifdef _OPENMP
+/**
+ * Order vertices by community, so that members of a community are contiguous (using OpenMP).
+ * @param a vertex keys in new order (output)
+ * @param x original graph
+ * @param vcom community each vertex belongs to (e.g., membership from leidenStaticOmp)
+ */
+template <class G, class K>
+inline void reorderByCommunityOmpW(vector<K>& a, const G& x, const vector<K>& vcom) {
+  auto fl = [&](K u, K v) { return vcom[u] < vcom[v] || (vcom[u] == vcom[v] && u < v); };
+  reorderVertexKeysW(a, x);
+  sortValuesOmpU(a, fl);
+}
+
+
+/**
+ * Order vertices by community, so that members of a community are contiguous (using OpenMP).
+ * @param x original graph
+ * @param vcom community each vertex belongs to (e.g., membership from leidenStaticOmp)
+ * @returns vertex keys in new order
+ */
+template <class G, class K>
+inline auto reorderByCommunityOmp(const G& x, const vector<K>& vcom) {
+  vector<K> a; reorderByCommunityOmpW(a, x, vcom);
+  return a;
+}
+#endif
+#pragma endregion
+
+
+
+
+#pragma region RELABEL
+/**
+ * Relabel vertices of a graph into a CSR, as per a new vertex order.
+ * @param a relabeled CSR graph (output)
+ * @param x original graph
+ * @param ks vertex keys in new order
+ * @param km new id of each vertex (see reorderMapW())
+ * @note Outgoing edges of each vertex are sorted by their new target id.
+ */
+template <class H, class G, class K>
+inline void relabelCsrW(H& a, const G& x, const vector<K>& ks, const vector<K>& km) {
+  using O = typename H::offset_type;
+  using E = typename H::edge_value_type;
+  size_t N = ks.size(), M = 0;
+  for (size_t i=0; i<N; ++i)
+    M += x.degree(ks[i]);
+  a.resize(N, M);
+  vector<pair<K, E>> es;
+  O o = O();
+  for (size_t i=0; i<N; ++i) {
+    K u = ks[i];
+    es.clear();
+    x.forEachEdge(u, [&](auto v, auto w) { es.push_back({km[v], w}); });
+    sort(es.begin(), es.end(), [](const auto& p, const auto& q) { return p.first < q.first; });
+    a.offsets[i] = o;
+    a.degrees[i] = K(es.size());
+    a.values[i]  = x.vertexValue(u);
+    for (const auto& [v, w] : es) {
+      a.edgeKeys[o]   = v;
+      a.edgeValues[o] = w;
+      ++o;
+    }
+  }
+  a.offsets[N] = o;
+}
+
+
+/**
+ * Relabel vertices of a graph into a CSR, as per a new vertex order.
+ * @param x original graph
+ * @param ks vertex keys in new order
+ * @returns relabeled CSR graph
+ */
+template <class G, class K>
+inline auto relabelCsr(const G& x, const vector<K>& ks) {
+  using V = typename G::vertex_value_type;
+  using E = typename G::edge_value_type;
+  DiGraphCsr<K, V, E> a;
+  vector<K> km(x.span());
+  reorderMapW(km, ks);
+  relabelCsrW(a, x, ks, km);
+  return a;
+}
+
+
+#ifdef _OPENMP
+/**
+ * Relabel vertices of a graph into a CSR, as per a new vertex order (using OpenMP).
+ * @param a relabeled CSR graph (output)
+ * @param x original graph
+ * @param ks vertex keys in new order
+ * @param km new id of each vertex (see reorderMapOmpW())
+ * @note Outgoing edges of each vertex are sorted by their new target id.
+ */
+template <class H, class G, class K>
+inline void relabelCsrOmpW(H& a, const G& x, const vector<K>& ks, const vector<K>& km) {
+  using O = typename H::offset_type;
+  using E = typename H::edge_value_type;
+  size_t N = ks.size();
+  int    T = omp_get_max_threads();
+  vector<O> buf(T);
+  vector<vector<pair<K, E>>> es(T);
+  size_t M = 0;
+  #pragma omp parallel for schedule(static, 2048) reduction(+:M)
+  for (size_t i=0; i<N; ++i)
+    M += x.degree(ks[i]);
+  a.resize(N, M);
+  // Find the offsets of the relabeled vertices.
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t i=0; i<N; ++i) {
+    a.degrees[i] = K(x.degree(ks[i]));
+    a.values[i]  = x.vertexValue(ks[i]);
+  }
+  a.offsets[N] = exclusiveScanOmpW(a.offsets, buf.data(), a.degrees, N);
+  // Copy the relabeled edges.
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (size_t i=0; i<N; ++i) {
+    int t = omp_get_thread_num();
+    es[t].clear();
+    x.forEachEdge(ks[i], [&](auto v, auto w) { es[t].push_back({km[v], w}); });
+    sort(es[t].begin(), es[t].end(), [](const auto& p, const auto& q) { return p.first < q.first; });
+    O o = a.offsets[i];
+    for (const auto& [v, w] : es[t]) {
+      a.edgeKeys[o]   = v;
+      a.edgeValues[o] = w;
+      ++o;
+    }
+  }
+}
+
+
+/**
+ * Relabel vertices of a graph into a CSR, as per a new vertex order (using OpenMP).
+ * @param x original graph
+ * @param ks vertex keys in new order
+ * @returns relabeled CSR graph
+ */
+template <class G, class K>
+inline auto relabelCsrOmp(const G& x, const vector<K>& ks) {
+  using V = typename G::vertex_value_type;
+  using E = typename G::edge_value_type;
+  DiGraphCsr<K, V, E> a;
+  vector<K> km(x.span());
+  reorderMapOmpW(km, ks);
+  relabelCsrOmpW(a, x, ks, km);
+  return a;
+}
+#endif
+#pragma endregion
+#pragma endregion
+} // namespace detail
+} // namespace gve
+
+
+
+
+// Now, we export the public API.
+EXPORT namespace gve {
+  // Methods
+  using detail::reorderMapW;
+  using detail::reorderValuesW;
+  using detail::reorderByDegreeW;
+  using detail::reorderByDegree;
+  using detail::reorderByRcmW;
+  using detail::reorderByRcm;
+  using detail::reorderByCommunityW;
+  using detail::reorderByCommunity;
+  using detail::relabelCsrW;
+  using detail::relabelCsr;
+#ifdef _OPENMP
+  using detail::reorderMapOmpW;
+  using detail::reorderValuesOmpW;
+  using detail::reorderByDegreeOmpW;
+  using detail::reorderByDegreeOmp;
+  using detail::reorderByRcmOmpW;
+  using detail::reorderByRcmOmp;
+  using detail::reorderByCommunityOmpW;
+  using detail::reorderByCommunityOmp;
+  using detail::relabelCsrOmpW;
+  using detail::relabelCsrOmp;
+#endif
+} // namespace gve
@@ -10,9 +10,16 @@
 #include <fstream>
 #include <algorithm>
 #include <cstdlib>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+#include <stdexcept>
 #include "_main.hxx"
 #include "Graph.hxx"
 #include "update.hxx"
+#include "io.hxx"
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -25,7 +32,13 @@
 namespace gve {
 namespace detail {
 using std::tuple;
+using std::pair;
+using std::vector;
 using std::string;
+using std::string_view;
+using std::min;
+using std::max;
+using std::get;
 
 
 
@@ -64,20 +77,18 @@ inline void readTemporalDo(const char *pth, bool weighted, bool symmetric, size_
 
 #ifdef _OPENMP
 /**
- * Read contents of SNAP Temporal file.
+ * Read contents of SNAP Temporal file, one block of lines at a time [helper function].
  * @param s input stream
  * @param weighted is it weighted?
- * @param symmetric is it symmetric?
  * @param rows number of rows/vertices
  * @param size number of lines/edges to read
- * @param fb on body line (u, v, w)
+ * @param fb on parsed block (edges {u, v, w}, number of edges)
  */
 template <class FB>
-inline void readTemporalDoOmp(std::istream& s, bool weighted, bool symmetric, size_t rows, size_t size, FB fb) {
+inline void readTemporalBlocksDoOmp(std::istream& s, bool weighted, size_t rows, size_t size, FB fb) {
   if (rows==0 || size==0) return;
   // Process body lines in parallel.
-  const int THREADS = omp_get_max_threads();
-  const int LINES   = 131072;
+  const int LINES = 131072;
   vector<string> lines(LINES);
   vector<tuple<size_t, size_t, double>> edges(LINES);
   while (size>0) {
@@ -95,21 +106,117 @@ inline void readTemporalDoOmp(std::istream& s, bool weighted, bool symmetric, si
       double w = weighted? strtod(line, &line) : 0;
       edges[i] = {u, v, w? w : 1};
     }
-    // Notify parsed lines.
-    #pragma omp parallel
-    {
-      for (int i=0; i<READ; ++i) {
-        const auto& [u, v, w] = edges[i];
-        fb(u, v, w);
-        if (symmetric) fb(v, u, w);
-      }
-    }
+    fb(edges, READ);
   }
 }
+
+
+/**
+ * Read contents of SNAP Temporal file.
+ * @param s input stream
+ * @param weighted is it weighted?
+ * @param symmetric is it symmetric?
+ * @param rows number of rows/vertices
+ * @param size number of lines/edges to read
+ * @param fb on body line (u, v, w)
+ */
 template <class FB>
-inline void readTemporalDoOmp(const char *pth, bool weighted, FB fb) {
+inline void readTemporalDoOmp(std::istream& s, bool weighted, bool symmetric, size_t rows, size_t size, FB fb) {
+  // Notify parsed lines, once each, in order.
+  readTemporalBlocksDoOmp(s, weighted, rows, size, [&](const auto& edges, int READ) {
+    for (int i=0; i<READ; ++i) {
+      const auto& [u, v, w] = edges[i];
+      fb(u, v, w);
+      if (symmetric) fb(v, u, w);
+    }
+  });
+}
+template <class FB>
+inline void readTemporalDoOmp(const char *pth, bool weighted, bool symmetric, size_t rows, size_t size, FB fb) {
   std::ifstream s(pth);
-  readTemporalDoOmp(s, weighted, fb);
+  readTemporalDoOmp(s, weighted, symmetric, rows, size, fb);
+}
+#endif
+#pragma endregion
+
+
+
+#pragma region READ SNAP TEMPORAL FORMAT
+/**
+ * Read SNAP Temporal data, with lines of the form "u v t".
+ * @tparam BASE base vertex id (0 or 1)
+ * @tparam CHECK check for error?
+ * @param data input file data
+ * @param symmetric is it symmetric?
+ * @param fb on body line (u, v, t)
+ */
+template <int BASE=0, bool CHECK=false, class FB>
+inline void readTemporalFormatDo(string_view data, bool symmetric, FB fb) {
+  readEdgelistFormatDo<true, BASE, CHECK>(data, symmetric, fb);
+}
+
+
+/**
+ * Read SNAP Temporal data as a list of temporal edges, in order.
+ * @tparam BASE base vertex id (0 or 1)
+ * @tparam CHECK check for error?
+ * @param a temporal edges {u, v, t} (output)
+ * @param data input file data
+ * @param symmetric is it symmetric?
+ */
+template <int BASE=0, bool CHECK=false, class K, class T>
+inline void readTemporalFormatToListW(vector<tuple<K, K, T>>& a, string_view data, bool symmetric) {
+  a.clear();
+  readTemporalFormatDo<BASE, CHECK>(data, symmetric, [&](auto u, auto v, auto t) {
+    a.push_back({K(u), K(v), T(t)});
+  });
+}
+
+
+#ifdef _OPENMP
+/**
+ * Read SNAP Temporal data as a list of temporal edges, in order (using OpenMP).
+ * Blocks of the data are parsed in parallel, and then concatenated in order.
+ * @tparam BASE base vertex id (0 or 1)
+ * @tparam CHECK check for error?
+ * @param a temporal edges {u, v, t} (output)
+ * @param data input file data
+ * @param symmetric is it symmetric?
+ */
+template <int BASE=0, bool CHECK=false, class K, class T>
+inline void readTemporalFormatToListOmpW(vector<tuple<K, K, T>>& a, string_view data, bool symmetric) {
+  const size_t DATA  = data.size();
+  const size_t BLOCK = 256 * 1024;  // Characters per block (256KB)
+  const size_t B = ceilDiv(DATA, BLOCK);
+  vector<vector<tuple<K, K, T>>> bedges(B);
+  vector<size_t> boffsets(B+1);
+  FormatError err;  // Common error
+  // Parse each block in parallel.
+  #pragma omp parallel for schedule(dynamic) shared(err)
+  for (size_t b=0; b<B; ++b) {
+    if (CHECK && !err.empty()) continue;
+    string_view bdata = readEdgelistFormatBlock(data, b*BLOCK, BLOCK);
+    auto fb = [&](auto u, auto v, auto t) { bedges[b].push_back({K(u), K(v), T(t)}); };
+    if constexpr (CHECK) {
+      try { readTemporalFormatDo<BASE, true>(bdata, symmetric, fb); }
+      catch (const FormatError& e) {
+        #pragma omp critical
+        if (err.empty()) err = e;
+      }
+    }
+    else readTemporalFormatDo<BASE>(bdata, symmetric, fb);
+  }
+  // Throw error if any.
+  if (CHECK && !err.empty()) throw err;
+  // Concatenate the blocks in order.
+  for (size_t b=0; b<B; ++b)
+    boffsets[b+1] = boffsets[b] + bedges[b].size();
+  a.resize(boffsets[B]);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b=0; b<B; ++b) {
+    std::copy(bedges[b].begin(), bedges[b].end(), a.begin() + boffsets[b]);
+    vector<tuple<K, K, T>>().swap(bedges[b]);
+  }
 }
 #endif
 #pragma endregion
@@ -117,6 +224,128 @@ inline void readTemporalDoOmp(const char *pth, bool weighted, FB fb) {
 
 
 
+#pragma region TEMPORAL BATCHES
+/**
+ * Hash function for an edge {u, v}.
+ * @tparam K key type (vertex id)
+ */
+template <class K>
+struct TemporalEdgeHash {
+  inline size_t operator()(const pair<K, K>& e) const noexcept {
+    return size_t((uint64_t(e.first) * 0x9E3779B97F4A7C15ULL) ^ uint64_t(e.second));
+  }
+};
+
+
+/**
+ * Obtain the batch update for a step of a temporal edge stream [helper function].
+ * An edge is present while at least one of its occurrences lies in the window.
+ * @param deletions edges leaving the graph {u, v, 1} (output)
+ * @param insertions edges entering the graph {u, v, 1} (output)
+ * @param counts occurrences of each edge in window (updated)
+ * @param prev occurrences of each edge touched in step, before it (scratch)
+ * @param edges temporal edges {u, v, t}
+ * @param xb begin index of occurrences leaving window
+ * @param xe end index of occurrences leaving window
+ * @param ib begin index of occurrences entering window
+ * @param ie end index of occurrences entering window
+ */
+template <class K, class T, class V, class M>
+inline void temporalBatchW(vector<tuple<K, K, V>>& deletions, vector<tuple<K, K, V>>& insertions, M& counts, M& prev, const vector<tuple<K, K, T>>& edges, size_t xb, size_t xe, size_t ib, size_t ie) {
+  auto fu = [&](size_t i, bool add) {
+    pair<K, K> e = {get<0>(edges[i]), get<1>(edges[i])};
+    auto& c = counts[e];
+    prev.emplace(e, c);
+    if (add) ++c; else --c;
+  };
+  deletions.clear();
+  insertions.clear();
+  prev.clear();
+  for (size_t i=xb; i<xe; ++i)
+    fu(i, false);
+  for (size_t i=ib; i<ie; ++i)
+    fu(i, true);
+  for (const auto& [e, c0] : prev) {
+    auto it = counts.find(e);
+    size_t c = (*it).second;
+    if (c0 >0 && c==0) deletions.push_back({e.first, e.second, V(1)});
+    if (c0==0 && c >0) insertions.push_back({e.first, e.second, V(1)});
+    if (c==0) counts.erase(it);
+  }
+  std::sort(deletions.begin(), deletions.end());
+  std::sort(insertions.begin(), insertions.end());
+}
+
+
+/**
+ * Replay a temporal edge stream as batch updates, with a sliding window of edges.
+ * @tparam V edge weight type of batch updates
+ * @param edges temporal edges {u, v, t}, in order of time
+ * @param window number of latest edges kept in graph (0 to keep all)
+ * @param step number of edges entering per batch update (must be positive)
+ * @param fb on batch update (deletions, insertions)
+ */
+template <class V=float, class K, class T, class FB>
+inline void temporalBatchesByCountDo(const vector<tuple<K, K, T>>& edges, size_t window, size_t step, FB fb) {
+  using  M = std::unordered_map<pair<K, K>, size_t, TemporalEdgeHash<K>>;
+  if (step==0) throw std::invalid_argument("Temporal batch step must be positive");
+  size_t E = edges.size();
+  vector<tuple<K, K, V>> deletions, insertions;
+  M counts, prev;
+  for (size_t ib=0; ib<E; ib+=step) {
+    size_t ie = min(ib+step, E);
+    size_t xb = window && ib>window? ib-window : 0;
+    size_t xe = window && ie>window? ie-window : 0;
+    temporalBatchW(deletions, insertions, counts, prev, edges, xb, xe, ib, ie);
+    fb(deletions, insertions);
+  }
+}
+
+
+/**
+ * Replay a temporal edge stream as batch updates, with a sliding window of time.
+ * Steps in which no edge enters or leaves the window are skipped, jumping past gaps in time.
+ * @tparam V edge weight type of batch updates
+ * @param edges temporal edges {u, v, t}, in order of time
+ * @param window duration of latest edges kept in graph (0 to keep all)
+ * @param step duration of each batch update (must be positive)
+ * @param fb on batch update (deletions, insertions)
+ */
+template <class V=float, class K, class T, class FB>
+inline void temporalBatchesByTimeDo(const vector<tuple<K, K, T>>& edges, T window, T step, FB fb) {
+  using  M = std::unordered_map<pair<K, K>, size_t, TemporalEdgeHash<K>>;
+  if (!(step > T())) throw std::invalid_argument("Temporal batch step must be positive");
+  size_t E = edges.size();
+  if (E==0) return;
+  vector<tuple<K, K, V>> deletions, insertions;
+  M counts, prev;
+  T t0 = get<2>(edges[0]);
+  // Get the first step whose window ends after time t.
+  auto fk = [&](T t) {
+    size_t k = size_t((t - t0) / step) + 1;
+    while (!(t < T(t0 + T(k) * step))) ++k;
+    return k;
+  };
+  for (size_t ib=0, xb=0, k=0; ib<E;) {
+    // Jump to the next step in which an edge enters or leaves the window.
+    size_t kn = fk(get<2>(edges[ib]));
+    if (window && xb<ib) kn = min(kn, fk(get<2>(edges[xb]) + window));
+    k = max(k+1, kn);
+    T tend = T(t0 + T(k) * step);
+    size_t ie = ib, xe = xb;
+    // Edges at [tend - window, tend) are in the window after this step.
+    while (ie<E && get<2>(edges[ie]) < tend) ++ie;
+    while (window && xe<ie && get<2>(edges[xe]) + window < tend) ++xe;
+    temporalBatchW(deletions, insertions, counts, prev, edges, xb, xe, ib, ie);
+    fb(deletions, insertions);
+    ib = ie; xb = xe;
+  }
+}
+#pragma endregion
+
+
+
+
 #pragma region READ SNAP TEMPORAL IF
 /**
  * Read SNAP Temporal file as graph if test passes.
@@ -164,8 +393,18 @@ inline void readTemporalIfOmpW(G &a, std::istream& s, bool weighted, bool symmet
   using V = typename G::vertex_value_type;
   using E = typename G::edge_value_type;
   addVerticesIfU(a, K(1), K(rows+1), V(), fv);
-  auto fb = [&](auto u, auto v, auto w) { if (fe(K(u), K(v), K(w))) addEdgeOmpU(a, K(u), K(v), E(w)); };
-  readTemporalDoOmp(s, weighted, symmetric, rows, size, fb);
+  auto fu = [&](auto u, auto v, auto w) { if (fe(K(u), K(v), K(w))) addEdgeOmpU(a, K(u), K(v), E(w)); };
+  // Insert each block as it is parsed; each thread adds the edges of the source vertices it owns.
+  readTemporalBlocksDoOmp(s, weighted, rows, size, [&](const auto& edges, int READ) {
+    #pragma omp parallel
+    {
+      for (int i=0; i<READ; ++i) {
+        const auto& [u, v, w] = edges[i];
+        fu(u, v, w);
+        if (symmetric) fu(v, u, w);
+      }
+    }
+  });
   updateOmpU(a);
 }
 template <class G, class FV, class FE>
@@ -238,8 +477,13 @@ EXPORT namespace gve {
   using detail::readTemporalDo;
   using detail::readTemporalIfW;
   using detail::readTemporalW;
+  using detail::readTemporalFormatDo;
+  using detail::readTemporalFormatToListW;
+  using detail::temporalBatchesByCountDo;
+  using detail::temporalBatchesByTimeDo;
 #ifdef _OPENMP
   using detail::readTemporalDoOmp;
+  using detail::readTemporalFormatToListOmpW;
   using detail::readTemporalIfOmpW;
   using detail::readTemporalOmpW;
 #endif
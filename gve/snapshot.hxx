@@ -0,0 +1,382 @@
+// Copyright (C) 2025 Subhajit Sahu
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// See LICENSE for full terms
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include <ostream>
+#include <fstream>
+#include "_main.hxx"
+#include "Graph.hxx"
+
+
+
+
+// An internal namespace helps to hide implementation details.
+// This is particularly useful for pre-C++20 modules.
+namespace gve {
+namespace detail {
+using std::vector;
+using std::ostream;
+using std::ofstream;
+using std::min;
+
+
+
+
+#pragma region CONSTANTS
+/** Magic bytes at the start of a graph snapshot. */
+#define GVE_SNAPSHOT_MAGIC "GVESNAP"
+/** Version of the graph snapshot format. */
+#define GVE_SNAPSHOT_VERSION 1
+/** Alignment of each section in a graph snapshot. */
+#define GVE_SNAPSHOT_ALIGNMENT GVE_PAGE_SIZE
+#pragma endregion
+
+
+
+
+#pragma region TYPES
+/**
+ * Header of a binary graph snapshot.
+ * @note The header occupies the first page of the file, and is followed by
+ * the offsets, degrees, edge keys, edge values, and vertex values sections,
+ * each aligned to page size. Sections of empty types (None) are not stored.
+ */
+struct SnapshotHeader {
+  #pragma region DATA
+  /** Magic bytes, GVE_SNAPSHOT_MAGIC. */
+  char magic[8];
+  /** Format version, GVE_SNAPSHOT_VERSION. */
+  uint32_t version;
+  /** Alignment of each section. */
+  uint32_t alignment;
+  /** Size of key type (vertex id). */
+  uint32_t keySize;
+  /** Size of vertex value type (vertex data), or 0 if empty. */
+  uint32_t vertexValueSize;
+  /** Size of edge value type (edge weight), or 0 if empty. */
+  uint32_t edgeValueSize;
+  /** Size of offset type (edge offset). */
+  uint32_t offsetSize;
+  /** Span of the graph, i.e., number of vertices. */
+  uint64_t span;
+  /** Size of the graph, i.e., number of edges. */
+  uint64_t size;
+  /** Position of offsets section (span+1 entries). */
+  uint64_t offsetsPosition;
+  /** Position of degrees section (span entries). */
+  uint64_t degreesPosition;
+  /** Position of edge keys section (size entries). */
+  uint64_t edgeKeysPosition;
+  /** Position of edge values section (size entries). */
+  uint64_t edgeValuesPosition;
+  /** Position of vertex values section (span entries). */
+  uint64_t valuesPosition;
+  /** Total size of the snapshot in bytes. */
+  uint64_t bytes;
+  #pragma endregion
+};
+#pragma endregion
+
+
+
+
+#pragma region METHODS
+#pragma region LAYOUT
+/**
+ * Get the size of a type as stored in a snapshot.
+ * @tparam T type of value
+ * @returns size of the type, or 0 if it is empty
+ */
+template <class T>
+inline constexpr uint32_t snapshotTypeSize() noexcept {
+  return std::is_empty_v<T>? 0 : uint32_t(sizeof(T));
+}
+
+
+/**
+ * Compute the layout of a graph snapshot.
+ * @tparam K key type (vertex id)
+ * @tparam V vertex value type (vertex data)
+ * @tparam E edge value type (edge weight)
+ * @tparam O offset type (edge offset)
+ * @param a snapshot header (output)
+ * @param N span of the graph
+ * @param M size of the graph
+ */
+template <class K, class V, class E, class O>
+inline void snapshotLayoutW(SnapshotHeader& a, size_t N, size_t M) {
+  const uint64_t A = GVE_SNAPSHOT_ALIGNMENT;
+  auto fsec = [&](uint64_t p, uint64_t n) { return ceilDiv(p + n, A) * A; };
+  memset(&a, 0, sizeof(SnapshotHeader));
+  memcpy(a.magic, GVE_SNAPSHOT_MAGIC, sizeof(GVE_SNAPSHOT_MAGIC));
+  a.version         = GVE_SNAPSHOT_VERSION;
+  a.alignment       = uint32_t(A);
+  a.keySize         = snapshotTypeSize<K>();
+  a.vertexValueSize = snapshotTypeSize<V>();
+  a.edgeValueSize   = snapshotTypeSize<E>();
+  a.offsetSize      = snapshotTypeSize<O>();
+  a.span = N;
+  a.size = M;
+  a.offsetsPosition    = fsec(0, sizeof(SnapshotHeader));
+  a.degreesPosition    = fsec(a.offsetsPosition,    (N+1) * a.offsetSize);
+  a.edgeKeysPosition   = fsec(a.degreesPosition,    N * a.keySize);
+  a.edgeValuesPosition = fsec(a.edgeKeysPosition,   M * a.keySize);
+  a.valuesPosition     = fsec(a.edgeValuesPosition, M * a.edgeValueSize);
+  a.bytes              = fsec(a.valuesPosition,     N * a.vertexValueSize);
+}
+#pragma endregion
+
+
+
+
+#pragma region WRITE SNAPSHOT
+/**
+ * Write a buffer of values to a snapshot stream, and clear it.
+ * @param a output stream
+ * @param buf buffer of values (updated)
+ */
+template <class T>
+inline void writeSnapshotFlushU(ostream& a, vector<T>& buf) {
+  if (!std::is_empty_v<T>) a.write((const char*) buf.data(), buf.size() * sizeof(T));
+  buf.clear();
+}
+
+
+/**
+ * Pad a snapshot stream with zeros, up to a given position.
+ * @param a output stream
+ * @param p current position (updated)
+ * @param q target position
+ */
+inline void writeSnapshotPadU(ostream& a, uint64_t& p, uint64_t q) {
+  const char zeros[256] = {};
+  for (; p<q;) {
+    uint64_t n = min(q-p, uint64_t(sizeof(zeros)));
+    a.write(zeros, n);
+    p += n;
+  }
+}
+
+
+/**
+ * Write a graph as a binary snapshot, which can later be memory mapped.
+ * @tparam O offset type (edge offset)
+ * @param a output stream
+ * @param x graph (DiGraphCsr, ArenaDiGraph, ...)
+ * @note Edges are stored compactly, i.e., without any capacity slack.
+ * @note Vertices absent in the graph are stored as isolated vertices.
+ */
+template <class O=size_t, class G>
+inline void writeSnapshot(ostream& a, const G& x) {
+  using  K = typename G::key_type;
+  using  V = typename G::vertex_value_type;
+  using  E = typename G::edge_value_type;
+  const size_t BUFFER = 1 << 16;
+  size_t N = x.span();
+  size_t M = 0;
+  for (size_t u=0; u<N; ++u)
+    M += x.hasVertex(K(u))? x.degree(K(u)) : 0;
+  SnapshotHeader h;
+  snapshotLayoutW<K, V, E, O>(h, N, M);
+  vector<O> bufo; bufo.reserve(BUFFER);
+  vector<K> bufk; bufk.reserve(BUFFER);
+  vector<E> bufe; bufe.reserve(BUFFER);
+  vector<V> bufv; bufv.reserve(BUFFER);
+  auto fdeg = [&](size_t u) { return x.hasVertex(K(u))? K(x.degree(K(u))) : K(); };
+  uint64_t p = 0;
+  // Write header.
+  a.write((const char*) &h, sizeof(SnapshotHeader));
+  p += sizeof(SnapshotHeader);
+  // Write offsets.
+  writeSnapshotPadU(a, p, h.offsetsPosition);
+  O i = O();
+  for (size_t u=0; u<=N; ++u) {
+    bufo.push_back(i);
+    if (u<N) i += fdeg(u);
+    if (bufo.size()>=BUFFER) writeSnapshotFlushU(a, bufo);
+  }
+  writeSnapshotFlushU(a, bufo);
+  p += (N+1) * h.offsetSize;
+  // Write degrees.
+  writeSnapshotPadU(a, p, h.degreesPosition);
+  for (size_t u=0; u<N; ++u) {
+    bufk.push_back(fdeg(u));
+    if (bufk.size()>=BUFFER) writeSnapshotFlushU(a, bufk);
+  }
+  writeSnapshotFlushU(a, bufk);
+  p += N * h.keySize;
+  // Write edge keys.
+  writeSnapshotPadU(a, p, h.edgeKeysPosition);
+  for (size_t u=0; u<N; ++u) {
+    if (!x.hasVertex(K(u))) continue;
+    x.forEachEdgeKey(K(u), [&](auto v) { bufk.push_back(v); });
+    if (bufk.size()>=BUFFER) writeSnapshotFlushU(a, bufk);
+  }
+  writeSnapshotFlushU(a, bufk);
+  p += M * h.keySize;
+  // Write edge values.
+  if (h.edgeValueSize) {
+    writeSnapshotPadU(a, p, h.edgeValuesPosition);
+    for (size_t u=0; u<N; ++u) {
+      if (!x.hasVertex(K(u))) continue;
+      x.forEachEdge(K(u), [&](auto v, auto w) { bufe.push_back(w); });
+      if (bufe.size()>=BUFFER) writeSnapshotFlushU(a, bufe);
+    }
+    writeSnapshotFlushU(a, bufe);
+    p += M * h.edgeValueSize;
+  }
+  // Write vertex values.
+  if (h.vertexValueSize) {
+    writeSnapshotPadU(a, p, h.valuesPosition);
+    for (size_t u=0; u<N; ++u) {
+      bufv.push_back(x.vertexValue(K(u)));
+      if (bufv.size()>=BUFFER) writeSnapshotFlushU(a, bufv);
+    }
+    writeSnapshotFlushU(a, bufv);
+    p += N * h.vertexValueSize;
+  }
+  writeSnapshotPadU(a, p, h.bytes);
+}
+
+
+/**
+ * Write a graph as a binary snapshot file, which can later be memory mapped.
+ * @tparam O offset type (edge offset)
+ * @param pth file path
+ * @param x graph (DiGraphCsr, ArenaDiGraph, ...)
+ * @returns success?
+ */
+template <class O=size_t, class G>
+inline bool writeSnapshot(const char *pth, const G& x) {
+  ofstream a(pth, std::ios::binary | std::ios::trunc);
+  if (!a) return false;
+  writeSnapshot<O>(a, x);
+  a.close();
+  return !a.fail();
+}
+#pragma endregion
+
+
+
+
+#pragma region READ SNAPSHOT
+/**
+ * Read and validate the header of a binary graph snapshot.
+ * @tparam K key type (vertex id)
+ * @tparam V vertex value type (vertex data)
+ * @tparam E edge value type (edge weight)
+ * @tparam O offset type (edge offset)
+ * @param a snapshot header (output)
+ * @param data snapshot data
+ * @param size snapshot size in bytes
+ */
+template <class K, class V, class E, class O>
+inline void readSnapshotHeaderW(SnapshotHeader& a, const void *data, size_t size) {
+  if (data==nullptr || size<sizeof(SnapshotHeader)) throw FormatError("Snapshot is too small");
+  memcpy(&a, data, sizeof(SnapshotHeader));
+  if (memcmp(a.magic, GVE_SNAPSHOT_MAGIC, sizeof(GVE_SNAPSHOT_MAGIC))!=0) throw FormatError("Snapshot has invalid magic");
+  if (a.version!=GVE_SNAPSHOT_VERSION) throw FormatError("Snapshot has unsupported version");
+  if (a.keySize!=snapshotTypeSize<K>() || a.vertexValueSize!=snapshotTypeSize<V>() ||
+      a.edgeValueSize!=snapshotTypeSize<E>() || a.offsetSize!=snapshotTypeSize<O>()) throw FormatError("Snapshot has mismatched types");
+  // Each section must fit in the snapshot, which also rules out overflow below.
+  if (a.span >= size / a.offsetSize || a.span > size / a.keySize || a.size > size / a.keySize ||
+     (a.edgeValueSize   && a.size > size / a.edgeValueSize) ||
+     (a.vertexValueSize && a.span > size / a.vertexValueSize)) throw FormatError("Snapshot is truncated");
+  SnapshotHeader b;
+  snapshotLayoutW<K, V, E, O>(b, a.span, a.size);
+  if (a.alignment!=b.alignment || a.offsetsPosition!=b.offsetsPosition || a.degreesPosition!=b.degreesPosition ||
+      a.edgeKeysPosition!=b.edgeKeysPosition || a.edgeValuesPosition!=b.edgeValuesPosition ||
+      a.valuesPosition!=b.valuesPosition || a.bytes!=b.bytes) throw FormatError("Snapshot has invalid layout");
+  if (size<a.bytes) throw FormatError("Snapshot is truncated");
+  auto fend = [&](uint64_t p, uint64_t n, uint32_t w) { return w==0 || p + n*w <= a.bytes; };
+  if (!fend(a.offsetsPosition,    a.span+1, a.offsetSize)      || !fend(a.degreesPosition, a.span, a.keySize) ||
+      !fend(a.edgeKeysPosition,   a.size,   a.keySize)         ||
+      !fend(a.edgeValuesPosition, a.size,   a.edgeValueSize)   ||
+      !fend(a.valuesPosition,     a.span,   a.vertexValueSize)) throw FormatError("Snapshot has invalid layout");
+}
+
+
+/**
+ * Validate the offsets, degrees, and edge keys of a binary graph snapshot.
+ * @tparam K key type (vertex id)
+ * @tparam O offset type (edge offset)
+ * @param h snapshot header
+ * @param offsets offsets of each vertex (span+1 entries)
+ * @param degrees degree of each vertex (span entries)
+ * @param edgeKeys target of each edge (size entries)
+ */
+template <class K, class O>
+inline void readSnapshotCsrCheck(const SnapshotHeader& h, const O *offsets, const K *degrees, const K *edgeKeys) {
+  size_t N = h.span;
+  if (offsets[0]!=O()) throw FormatError("Snapshot has invalid offsets");
+  for (size_t u=0; u<N; ++u) {
+    if (offsets[u+1] < offsets[u] || uint64_t(degrees[u]) > uint64_t(offsets[u+1] - offsets[u])) throw FormatError("Snapshot has invalid offsets");
+  }
+  if (uint64_t(offsets[N])!=h.size) throw FormatError("Snapshot has invalid offsets");
+  for (size_t i=0; i<h.size; ++i)
+    if (uint64_t(edgeKeys[i]) >= N) throw FormatError("Snapshot has invalid edge keys");
+}
+
+
+/**
+ * Read a binary graph snapshot into CSR, without copying.
+ * @param a output csr graph (updated)
+ * @param data snapshot data (e.g., memory mapped file)
+ * @param size snapshot size in bytes
+ * @note The graph points into the snapshot data, which must outlive it.
+ * @note The graph does not own the data, and cannot be resized. The arrays it held before are freed.
+ * @note The offsets, degrees, and edge keys are validated, which reads them once.
+ */
+template <class G>
+inline void readSnapshotCsrW(G& a, const void *data, size_t size) {
+  using K = typename G::key_type;
+  using V = typename G::vertex_value_type;
+  using E = typename G::edge_value_type;
+  using O = typename G::offset_type;
+  SnapshotHeader h;
+  readSnapshotHeaderW<K, V, E, O>(h, data, size);
+  char *base = (char*) data;
+  O *offsets = (O*) (base + h.offsetsPosition);
+  K *degrees = (K*) (base + h.degreesPosition);
+  K *edgeKeys = (K*) (base + h.edgeKeysPosition);
+  readSnapshotCsrCheck(h, offsets, degrees, edgeKeys);
+  a.viewArrays(offsets, degrees, edgeKeys, (E*) (base + h.edgeValuesPosition), (V*) (base + h.valuesPosition), h.span, h.size);
+}
+
+
+/**
+ * Read a memory mapped binary graph snapshot into CSR, without copying.
+ * @param a output csr graph (updated)
+ * @param file memory mapped snapshot file
+ * @note The graph points into the mapped file, which must outlive it.
+ * @note The graph does not own the data, and cannot be resized.
+ */
+template <class G>
+inline void readSnapshotCsrW(G& a, const MappedFile& file) {
+  readSnapshotCsrW(a, file.data(), file.size());
+}
+#pragma endregion
+#pragma endregion
+} // namespace detail
+} // namespace gve
+
+
+
+
+// Now, we export the public API.
+EXPORT namespace gve {
+  // Types
+  using detail::SnapshotHeader;
+  // Methods
+  using detail::snapshotTypeSize;
+  using detail::snapshotLayoutW;
+  using detail::writeSnapshot;
+  using detail::readSnapshotHeaderW;
+  using detail::readSnapshotCsrCheck;
+  using detail::readSnapshotCsrW;
+} // namespace gve
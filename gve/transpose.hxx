@@ -3,9 +3,16 @@
 // See LICENSE for full terms
 #pragma once
 
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
 #include "_main.hxx"
 #include "Graph.hxx"
 #include "update.hxx"
+#include "batch.hxx"
+#include "duplicate.hxx"
 
 
 
@@ -14,6 +21,15 @@
 // This is particularly useful for pre-C++20 modules.
 namespace gve {
 namespace detail {
+using std::tuple;
+using std::pair;
+using std::vector;
+using std::get;
+using std::min;
+
+
+
+
 #pragma region METHODS
 #pragma region TRANSPOSE
 /**
@@ -146,6 +162,633 @@ inline auto transposeWithDegreeOmp(const G& x) {
 
 
 
+
+#pragma region TRANSPOSE CSR
+/**
+ * Find the offsets of each vertex in CSR from its degree, with slack for future insertions [helper function].
+ * @param a csr graph with degrees (updated)
+ * @param slack fraction of extra edge slots per vertex
+ * @note The edge arrays are grown if needed, keeping the degrees.
+ */
+template <class K, class V, class E, class O>
+inline void transposeCsrOffsetsW(DiGraphCsr<K, V, E, O>& a, double slack) {
+  size_t S = a.span();
+  size_t C = 0;
+  for (size_t v=0; v<S; ++v)
+    C += duplicateCsrCapacity<O>(a.degrees[v], slack);
+  if (C > a.CAPACITY) {
+    vector<K> ds(a.degrees, a.degrees + S);
+    a.resize(S, C);
+    copyValuesW(a.degrees, ds.data(), S);
+  }
+  for (size_t v=0; v<S; ++v)
+    a.offsets[v] = duplicateCsrCapacity<O>(a.degrees[v], slack);
+  a.offsets[S] = O();
+  exclusiveScanW(a.offsets, a.offsets, S+1);
+}
+
+
+/**
+ * Transpose a graph into CSR with a counting sort [helper function].
+ * @param a transposed graph (output)
+ * @param x graph to transpose
+ * @param fv vertex value of each vertex in transposed graph (u)
+ * @param slack fraction of extra edge slots per vertex
+ * @note The edges of each vertex are sorted by id.
+ */
+template <class K, class V, class E, class O, class G, class FV>
+inline void transposeCsrDoW(DiGraphCsr<K, V, E, O>& a, const G& x, FV fv, double slack=0) {
+  size_t S = x.span();
+  size_t M = x.size();
+  a.resize(S, M);
+  // Find the in-degree, and then the offsets, of each vertex.
+  fillValueU(a.degrees, S, K());
+  x.forEachVertexKey([&](auto u) {
+    x.forEachEdgeKey(u, [&](auto v) { ++a.degrees[v]; });
+  });
+  transposeCsrOffsetsW(a, slack);
+  for (size_t v=0; v<S; ++v)
+    a.values[v] = fv(K(v));
+  // Place the edges, visiting sources in order, using the degrees as insertion cursors.
+  fillValueU(a.degrees, S, K());
+  x.forEachVertexKey([&](auto u) {
+    x.forEachEdge(u, [&](auto v, auto w) {
+      O j = a.offsets[v] + a.degrees[v]++;
+      a.edgeKeys[j] = K(u);
+      if constexpr (!std::is_empty_v<E>) a.edgeValues[j] = E(w);
+    });
+  });
+}
+
+
+/**
+ * Transpose a graph into CSR.
+ * @param a transposed graph (output)
+ * @param x graph to transpose
+ * @param slack fraction of extra edge slots per vertex, for batch updates
+ * @note The edges of each vertex are sorted by id.
+ */
+template <class K, class V, class E, class O, class G>
+inline void transposeCsrW(DiGraphCsr<K, V, E, O>& a, const G& x, double slack=0) {
+  auto fv = [&](K u) { return x.hasVertex(u)? V(x.vertexValue(u)) : V(); };
+  transposeCsrDoW(a, x, fv, slack);
+}
+
+/**
+ * Transpose a graph into CSR.
+ * @param x graph to transpose
+ * @returns transposed graph
+ */
+template <class G>
+inline auto transposeCsr(const G& x) {
+  using K = typename G::key_type;
+  using V = typename G::vertex_value_type;
+  using E = typename G::edge_value_type;
+  DiGraphCsr<K, V, E> a; transposeCsrW(a, x);
+  return a;
+}
+
+
+/**
+ * Transpose a graph into CSR, with out-degree as vertex value.
+ * @param a transposed graph with degree (output)
+ * @param x graph to transpose
+ * @param slack fraction of extra edge slots per vertex, for batch updates
+ * @note The edges of each vertex are sorted by id.
+ */
+template <class K, class V, class E, class O, class G>
+inline void transposeWithDegreeCsrW(DiGraphCsr<K, V, E, O>& a, const G& x, double slack=0) {
+  auto fv = [&](K u) { return x.hasVertex(u)? V(x.degree(u)) : V(); };
+  transposeCsrDoW(a, x, fv, slack);
+}
+
+/**
+ * Transpose a graph into CSR, with out-degree as vertex value.
+ * @param x graph to transpose
+ * @returns transposed graph with degree
+ */
+template <class G>
+inline auto transposeWithDegreeCsr(const G& x) {
+  using K = typename G::key_type;
+  using E = typename G::edge_value_type;
+  DiGraphCsr<K, K, E> a; transposeWithDegreeCsrW(a, x);
+  return a;
+}
+
+
+#ifdef _OPENMP
+/**
+ * Find the offsets of each vertex in CSR from its degree, with slack for future insertions, in parallel [helper function].
+ * @param a csr graph with degrees (updated)
+ * @param slack fraction of extra edge slots per vertex
+ * @note The edge arrays are grown if needed, keeping the degrees.
+ */
+template <class K, class V, class E, class O>
+inline void transposeCsrOffsetsOmpW(DiGraphCsr<K, V, E, O>& a, double slack) {
+  size_t S = a.span();
+  size_t C = 0;
+  vector<O> buf(omp_get_max_threads());
+  #pragma omp parallel for schedule(static, 2048) reduction(+:C)
+  for (size_t v=0; v<S; ++v)
+    C += duplicateCsrCapacity<O>(a.degrees[v], slack);
+  if (C > a.CAPACITY) {
+    vector<K> ds(S);
+    copyValuesOmpW(ds.data(), a.degrees, S);
+    a.resize(S, C);
+    copyValuesOmpW(a.degrees, ds.data(), S);
+  }
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t v=0; v<S; ++v)
+    a.offsets[v] = duplicateCsrCapacity<O>(a.degrees[v], slack);
+  a.offsets[S] = O();
+  exclusiveScanOmpW(a.offsets, buf.data(), a.offsets, S+1);
+}
+
+
+/**
+ * Transpose a graph into CSR with a counting sort, in parallel [helper function].
+ * @param a transposed graph (output)
+ * @param x graph to transpose
+ * @param fv vertex value of each vertex in transposed graph (u)
+ * @param slack fraction of extra edge slots per vertex
+ * @note The edges of each vertex are sorted by id. Sources are split into
+ * contiguous blocks with nearly equal edges, and each block counts its edges
+ * per target. Each block then writes its edges, in source order, to the slots
+ * after those of the blocks before it. So, no atomics or sorting is needed.
+ */
+template <class K, class V, class E, class O, class G, class FV>
+inline void transposeCsrDoOmpW(DiGraphCsr<K, V, E, O>& a, const G& x, FV fv, double slack=0) {
+  size_t S = x.span();
+  size_t M = x.size();
+  size_t B = omp_get_max_threads();
+  a.resize(S, M);
+  // Split the sources into blocks with nearly equal edges.
+  vector<size_t> ws(S+1), bs(B+1), buf(B);
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t u=0; u<S; ++u)
+    ws[u] = x.hasVertex(K(u))? x.degree(K(u)) : 0;
+  ws[S] = 0;
+  size_t W = exclusiveScanOmpW(ws.data(), buf.data(), ws.data(), S+1);
+  for (size_t b=0; b<=B; ++b)
+    bs[b] = std::lower_bound(ws.begin(), ws.begin()+S, b * W / B) - ws.begin();
+  bs[B] = S;
+  // Count the edges of each block, per target.
+  vector<K> cs(B * S);
+  #pragma omp parallel for schedule(static, 1)
+  for (size_t b=0; b<B; ++b) {
+    K *cb = cs.data() + b*S;
+    fillValueU(cb, S, K());
+    for (size_t u=bs[b]; u<bs[b+1]; ++u) {
+      if (!x.hasVertex(K(u))) continue;
+      x.forEachEdgeKey(K(u), [&](auto v) { ++cb[v]; });
+    }
+  }
+  // Find the in-degree of each vertex, and the first slot of each block for it.
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t v=0; v<S; ++v) {
+    K i = K();
+    for (size_t b=0; b<B; ++b) {
+      K c = cs[b*S + v];
+      cs[b*S + v] = i;
+      i += c;
+    }
+    a.degrees[v] = i;
+  }
+  // Find the offsets of each vertex.
+  transposeCsrOffsetsOmpW(a, slack);
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t v=0; v<S; ++v)
+    a.values[v] = fv(K(v));
+  // Place the edges of each block, visiting sources in order.
+  #pragma omp parallel for schedule(static, 1)
+  for (size_t b=0; b<B; ++b) {
+    K *cb = cs.data() + b*S;
+    for (size_t u=bs[b]; u<bs[b+1]; ++u) {
+      if (!x.hasVertex(K(u))) continue;
+      x.forEachEdge(K(u), [&](auto v, auto w) {
+        O j = a.offsets[v] + cb[v]++;
+        a.edgeKeys[j] = K(u);
+        if constexpr (!std::is_empty_v<E>) a.edgeValues[j] = E(w);
+      });
+    }
+  }
+}
+
+
+/**
+ * Transpose a graph into CSR in parallel.
+ * @param a transposed graph (output)
+ * @param x graph to transpose
+ * @param slack fraction of extra edge slots per vertex, for batch updates
+ * @note The edges of each vertex are sorted by id.
+ */
+template <class K, class V, class E, class O, class G>
+inline void transposeCsrOmpW(DiGraphCsr<K, V, E, O>& a, const G& x, double slack=0) {
+  auto fv = [&](K u) { return x.hasVertex(u)? V(x.vertexValue(u)) : V(); };
+  transposeCsrDoOmpW(a, x, fv, slack);
+}
+
+/**
+ * Transpose a graph into CSR in parallel.
+ * @param x graph to transpose
+ * @returns transposed graph
+ */
+template <class G>
+inline auto transposeCsrOmp(const G& x) {
+  using K = typename G::key_type;
+  using V = typename G::vertex_value_type;
+  using E = typename G::edge_value_type;
+  DiGraphCsr<K, V, E> a; transposeCsrOmpW(a, x);
+  return a;
+}
+
+
+/**
+ * Transpose a graph into CSR, with out-degree as vertex value, in parallel.
+ * @param a transposed graph with degree (output)
+ * @param x graph to transpose
+ * @param slack fraction of extra edge slots per vertex, for batch updates
+ * @note The edges of each vertex are sorted by id.
+ */
+template <class K, class V, class E, class O, class G>
+inline void transposeWithDegreeCsrOmpW(DiGraphCsr<K, V, E, O>& a, const G& x, double slack=0) {
+  auto fv = [&](K u) { return x.hasVertex(u)? V(x.degree(u)) : V(); };
+  transposeCsrDoOmpW(a, x, fv, slack);
+}
+
+/**
+ * Transpose a graph into CSR, with out-degree as vertex value, in parallel.
+ * @param x graph to transpose
+ * @returns transposed graph with degree
+ */
+template <class G>
+inline auto transposeWithDegreeCsrOmp(const G& x) {
+  using K = typename G::key_type;
+  using E = typename G::edge_value_type;
+  DiGraphCsr<K, K, E> a; transposeWithDegreeCsrOmpW(a, x);
+  return a;
+}
+#endif
+#pragma endregion
+
+
+
+
+#pragma region TRANSPOSE BATCH
+/**
+ * Reverse the edges in a batch update.
+ * @param a reversed edges (output)
+ * @param edges edges in batch update
+ */
+template <class K, class V>
+inline void transposeBatchW(vector<tuple<K, K, V>>& a, const vector<tuple<K, K, V>>& edges) {
+  a.clear();
+  a.reserve(edges.size());
+  for (auto [u, v, w] : edges)
+    a.push_back({v, u, w});
+}
+
+
+/**
+ * Update the transpose of a graph with a batch update, applied to the graph.
+ * @param a transposed graph (updated)
+ * @param deletions edge deletions in batch update, of the graph
+ * @param insertions edge insertions in batch update, of the graph
+ * @note Only the vertices in the batch are visited, if a is an ArenaDiGraph.
+ */
+template <class H, class K, class V>
+inline void transposeBatchUpdateU(H& a, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions) {
+  vector<tuple<K, K, V>> dt, it;
+  transposeBatchW(dt, deletions);
+  transposeBatchW(it, insertions);
+  applyBatchUpdateU(a, dt, it);
+}
+
+
+/**
+ * Update the transpose of a graph, with out-degree as vertex value, with a batch update applied to the graph.
+ * @param a transposed graph with degree (updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update, of the graph
+ * @param insertions edge insertions in batch update, of the graph
+ * @note Only the vertices in the batch are visited, if a is an ArenaDiGraph.
+ */
+template <class H, class G, class K, class V>
+inline void transposeWithDegreeBatchUpdateU(H& a, const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions) {
+  using W = typename H::vertex_value_type;
+  transposeBatchUpdateU(a, deletions, insertions);
+  auto fu = [&](K u) { if (a.hasVertex(u)) a.setVertexValue(u, W(y.degree(u))); };
+  for (auto [u, v, w] : deletions)
+    fu(u);
+  for (auto [u, v, w] : insertions) {
+    fu(u);
+    fu(v);
+  }
+}
+
+
+/**
+ * Merge the batch update of a vertex into its edges in a transposed CSR [helper function].
+ * @param a merged edges {source, weight} (output)
+ * @param x transposed graph
+ * @param v vertex id
+ * @param db begin of reversed deletions of vertex, sorted by source
+ * @param de end of reversed deletions of vertex
+ * @param ib begin of reversed insertions of vertex, sorted by source
+ * @param ie end of reversed insertions of vertex
+ */
+template <class K, class V, class E, class O, class I>
+inline void transposeCsrMergeW(vector<pair<K, E>>& a, const DiGraphCsr<K, V, E, O>& x, K v, I db, I de, I ib, I ie) {
+  auto fw = [&](O j) { if constexpr (std::is_empty_v<E>) return E(); else return x.edgeValues[j]; };
+  O j = x.offsets[v];
+  O J = j + x.degrees[v];
+  a.clear();
+  for (; j<J; ++j) {
+    K u = x.edgeKeys[j];
+    for (; ib<ie && get<1>(*ib) < u; ++ib)
+      a.push_back({get<1>(*ib), E(get<2>(*ib))});
+    for (; db<de && get<1>(*db) < u; ++db);
+    if (ib<ie && get<1>(*ib)==u) { a.push_back({u, E(get<2>(*ib))}); ++ib; }
+    else if (db==de || get<1>(*db)!=u) a.push_back({u, fw(j)});
+  }
+  for (; ib<ie; ++ib)
+    a.push_back({get<1>(*ib), E(get<2>(*ib))});
+}
+
+
+/**
+ * Write the merged edges of a vertex into its slots in a transposed CSR [helper function].
+ * @param a transposed graph (updated)
+ * @param v vertex id
+ * @param es merged edges {source, weight}
+ * @returns were there enough slots?
+ */
+template <class K, class V, class E, class O>
+inline bool transposeCsrWriteU(DiGraphCsr<K, V, E, O>& a, K v, const vector<pair<K, E>>& es) {
+  O i = a.offsets[v];
+  if (es.size() > size_t(a.offsets[v+1] - i)) return false;
+  for (const auto& [u, w] : es) {
+    a.edgeKeys[i] = u;
+    if constexpr (!std::is_empty_v<E>) a.edgeValues[i] = w;
+    ++i;
+  }
+  a.degrees[v] = K(es.size());
+  return true;
+}
+
+
+/**
+ * Update the transpose of a graph in CSR with a batch update applied to the graph [helper function].
+ * @param a transposed graph, with sorted edges (updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update, of the graph
+ * @param insertions edge insertions in batch update, of the graph
+ * @param fv vertex value of each vertex in transposed graph (u)
+ * @param slack fraction of extra edge slots per vertex, if rebuilt
+ * @returns were only the vertices in the batch updated (false if rebuilt)?
+ */
+template <class K, class V, class E, class O, class G, class W, class FV>
+inline bool transposeCsrBatchUpdateDoU(DiGraphCsr<K, V, E, O>& a, const G& y, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions, FV fv, double slack) {
+  if (a.span() != y.span()) { transposeCsrDoW(a, y, fv, slack); return false; }
+  vector<tuple<K, K, W>> dt, it;
+  vector<pair<K, E>> es;
+  transposeBatchW(dt, deletions);
+  transposeBatchW(it, insertions);
+  sortEdgesByIdU(dt);
+  sortEdgesByIdU(it);
+  // Merge the batch into the edges of each target vertex, in order.
+  auto db = dt.begin(), ib = it.begin();
+  while (db<dt.end() || ib<it.end()) {
+    K v  = db==dt.end()? get<0>(*ib) : ib==it.end()? get<0>(*db) : min(get<0>(*db), get<0>(*ib));
+    auto de = db, ie = ib;
+    for (; de<dt.end() && get<0>(*de)==v; ++de);
+    for (; ie<it.end() && get<0>(*ie)==v; ++ie);
+    transposeCsrMergeW(es, a, v, db, de, ib, ie);
+    if (!transposeCsrWriteU(a, v, es)) { transposeCsrDoW(a, y, fv, slack); return false; }
+    db = de; ib = ie;
+  }
+  // Update the vertex values of the source vertices.
+  for (const auto& [u, v, w] : deletions)
+    a.values[u] = fv(u);
+  for (const auto& [u, v, w] : insertions)
+    a.values[u] = fv(u);
+  return true;
+}
+
+
+/**
+ * Update the transpose of a graph in CSR with a batch update applied to the graph.
+ * @param a transposed graph, from transposeCsrW() (updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update, of the graph
+ * @param insertions edge insertions in batch update, of the graph
+ * @param slack fraction of extra edge slots per vertex, if rebuilt
+ * @returns were only the vertices in the batch updated (false if rebuilt)?
+ * @note The transpose is rebuilt only if a vertex runs out of edge slots.
+ */
+template <class K, class V, class E, class O, class G, class W>
+inline bool transposeCsrBatchUpdateU(DiGraphCsr<K, V, E, O>& a, const G& y, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions, double slack=0) {
+  auto fv = [&](K u) { return y.hasVertex(u)? V(y.vertexValue(u)) : V(); };
+  return transposeCsrBatchUpdateDoU(a, y, deletions, insertions, fv, slack);
+}
+
+
+/**
+ * Update the transpose of a graph in CSR, with out-degree as vertex value, with a batch update applied to the graph.
+ * @param a transposed graph with degree, from transposeWithDegreeCsrW() (updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update, of the graph
+ * @param insertions edge insertions in batch update, of the graph
+ * @param slack fraction of extra edge slots per vertex, if rebuilt
+ * @returns were only the vertices in the batch updated (false if rebuilt)?
+ * @note The transpose is rebuilt only if a vertex runs out of edge slots.
+ */
+template <class K, class V, class E, class O, class G, class W>
+inline bool transposeWithDegreeCsrBatchUpdateU(DiGraphCsr<K, V, E, O>& a, const G& y, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions, double slack=0) {
+  auto fv = [&](K u) { return y.hasVertex(u)? V(y.degree(u)) : V(); };
+  return transposeCsrBatchUpdateDoU(a, y, deletions, insertions, fv, slack);
+}
+
+
+#ifdef _OPENMP
+/**
+ * Reverse the edges in a batch update in parallel.
+ * @param a reversed edges (output)
+ * @param edges edges in batch update
+ */
+template <class K, class V>
+inline void transposeBatchOmpW(vector<tuple<K, K, V>>& a, const vector<tuple<K, K, V>>& edges) {
+  size_t N = edges.size();
+  a.resize(N);
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t i=0; i<N; ++i) {
+    auto [u, v, w] = edges[i];
+    a[i] = {v, u, w};
+  }
+}
+
+
+/**
+ * Update the transpose of a graph with a batch update, applied to the graph, in parallel.
+ * @param a transposed graph (updated)
+ * @param deletions edge deletions in batch update, of the graph
+ * @param insertions edge insertions in batch update, of the graph
+ * @note Only the vertices in the batch are visited, if a is an ArenaDiGraph.
+ */
+template <class H, class K, class V>
+inline void transposeBatchUpdateOmpU(H& a, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions) {
+  vector<tuple<K, K, V>> dt, it;
+  transposeBatchOmpW(dt, deletions);
+  transposeBatchOmpW(it, insertions);
+  applyBatchUpdateOmpU(a, dt, it);
+}
+
+
+/**
+ * Update the transpose of a graph, with out-degree as vertex value, with a batch update applied to the graph, in parallel.
+ * @param a transposed graph with degree (updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update, of the graph
+ * @param insertions edge insertions in batch update, of the graph
+ * @note Only the vertices in the batch are visited, if a is an ArenaDiGraph.
+ */
+template <class H, class G, class K, class V>
+inline void transposeWithDegreeBatchUpdateOmpU(H& a, const G& y, const vector<tuple<K, K, V>>& deletions, const vector<tuple<K, K, V>>& insertions) {
+  using W = typename H::vertex_value_type;
+  transposeBatchUpdateOmpU(a, deletions, insertions);
+  // Find the vertices in the batch, so that each is written by one thread.
+  size_t ND = deletions.size();
+  size_t NI = insertions.size();
+  vector<K> us(ND + 2*NI);
+  #pragma omp parallel
+  {
+    #pragma omp for schedule(static, 2048) nowait
+    for (size_t i=0; i<ND; ++i)
+      us[i] = get<0>(deletions[i]);
+    #pragma omp for schedule(static, 2048) nowait
+    for (size_t i=0; i<NI; ++i) {
+      us[ND + 2*i]   = get<0>(insertions[i]);
+      us[ND + 2*i+1] = get<1>(insertions[i]);
+    }
+  }
+  sortValuesOmpU(us, [](K u, K v) { return u < v; });
+  us.erase(std::unique(us.begin(), us.end()), us.end());
+  // Update the out-degree of each vertex in the batch.
+  size_t N = us.size();
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t i=0; i<N; ++i) {
+    K u = us[i];
+    if (a.hasVertex(u)) a.setVertexValue(u, W(y.degree(u)));
+  }
+}
+
+
+/**
+ * Update the transpose of a graph in CSR with a batch update applied to the graph, in parallel [helper function].
+ * @param a transposed graph, with sorted edges (updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update, of the graph
+ * @param insertions edge insertions in batch update, of the graph
+ * @param fv vertex value of each vertex in transposed graph (u)
+ * @param slack fraction of extra edge slots per vertex, if rebuilt
+ * @returns were only the vertices in the batch updated (false if rebuilt)?
+ */
+template <class K, class V, class E, class O, class G, class W, class FV>
+inline bool transposeCsrBatchUpdateDoOmpU(DiGraphCsr<K, V, E, O>& a, const G& y, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions, FV fv, double slack) {
+  if (a.span() != y.span()) { transposeCsrDoOmpW(a, y, fv, slack); return false; }
+  vector<tuple<K, K, W>> dt, it;
+  transposeBatchOmpW(dt, deletions);
+  transposeBatchOmpW(it, insertions);
+  sortEdgesByIdOmpU(dt);
+  sortEdgesByIdOmpU(it);
+  // Find the target vertices, and the source vertices, in the batch.
+  size_t ND = dt.size();
+  size_t NI = it.size();
+  vector<K> vs(ND + NI), us(ND + NI);
+  #pragma omp parallel
+  {
+    #pragma omp for schedule(static, 2048) nowait
+    for (size_t i=0; i<ND; ++i) {
+      vs[i] = get<0>(dt[i]);
+      us[i] = get<1>(dt[i]);
+    }
+    #pragma omp for schedule(static, 2048) nowait
+    for (size_t i=0; i<NI; ++i) {
+      vs[ND+i] = get<0>(it[i]);
+      us[ND+i] = get<1>(it[i]);
+    }
+  }
+  auto fl = [](K u, K v) { return u < v; };
+  std::inplace_merge(vs.begin(), vs.begin() + ND, vs.end());
+  vs.erase(std::unique(vs.begin(), vs.end()), vs.end());
+  sortValuesOmpU(us, fl);
+  us.erase(std::unique(us.begin(), us.end()), us.end());
+  // Merge the batch into the edges of each target vertex.
+  auto fk = [](const auto& e, K v) { return get<0>(e) < v; };
+  size_t NV = vs.size();
+  bool fits = true;
+  #pragma omp parallel reduction(&&:fits)
+  {
+    vector<pair<K, E>> es;
+    #pragma omp for schedule(dynamic, 64)
+    for (size_t i=0; i<NV; ++i) {
+      K v  = vs[i];
+      auto db = std::lower_bound(dt.begin(), dt.end(), v, fk);
+      auto ib = std::lower_bound(it.begin(), it.end(), v, fk);
+      auto de = db, ie = ib;
+      for (; de<dt.end() && get<0>(*de)==v; ++de);
+      for (; ie<it.end() && get<0>(*ie)==v; ++ie);
+      transposeCsrMergeW(es, a, v, db, de, ib, ie);
+      fits = transposeCsrWriteU(a, v, es) && fits;
+    }
+  }
+  if (!fits) { transposeCsrDoOmpW(a, y, fv, slack); return false; }
+  // Update the vertex values of the source vertices.
+  size_t NU = us.size();
+  #pragma omp parallel for schedule(static, 2048)
+  for (size_t i=0; i<NU; ++i)
+    a.values[us[i]] = fv(us[i]);
+  return true;
+}
+
+
+/**
+ * Update the transpose of a graph in CSR with a batch update applied to the graph, in parallel.
+ * @param a transposed graph, from transposeCsrOmpW() (updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update, of the graph
+ * @param insertions edge insertions in batch update, of the graph
+ * @param slack fraction of extra edge slots per vertex, if rebuilt
+ * @returns were only the vertices in the batch updated (false if rebuilt)?
+ * @note The transpose is rebuilt only if a vertex runs out of edge slots.
+ */
+template <class K, class V, class E, class O, class G, class W>
+inline bool transposeCsrBatchUpdateOmpU(DiGraphCsr<K, V, E, O>& a, const G& y, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions, double slack=0) {
+  auto fv = [&](K u) { return y.hasVertex(u)? V(y.vertexValue(u)) : V(); };
+  return transposeCsrBatchUpdateDoOmpU(a, y, deletions, insertions, fv, slack);
+}
+
+
+/**
+ * Update the transpose of a graph in CSR, with out-degree as vertex value, with a batch update applied to the graph, in parallel.
+ * @param a transposed graph with degree, from transposeWithDegreeCsrOmpW() (updated)
+ * @param y updated graph
+ * @param deletions edge deletions in batch update, of the graph
+ * @param insertions edge insertions in batch update, of the graph
+ * @param slack fraction of extra edge slots per vertex, if rebuilt
+ * @returns were only the vertices in the batch updated (false if rebuilt)?
+ * @note The transpose is rebuilt only if a vertex runs out of edge slots.
+ */
+template <class K, class V, class E, class O, class G, class W>
+inline bool transposeWithDegreeCsrBatchUpdateOmpU(DiGraphCsr<K, V, E, O>& a, const G& y, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions, double slack=0) {
+  auto fv = [&](K u) { return y.hasVertex(u)? V(y.degree(u)) : V(); };
+  return transposeCsrBatchUpdateDoOmpU(a, y, deletions, insertions, fv, slack);
+}
+#endif
+#pragma endregion
+
+
+
 #pragma region ARENA-BASED DIGRAPH
 template <int PARTITIONS=8, int CHUNK_SIZE=32, class H, class G>
 inline void transposeArenaOmpW(H &a, const G& x) {
@@ -280,11 +923,29 @@ EXPORT namespace gve {
   using detail::transpose;
   using detail::transposeWithDegreeW;
   using detail::transposeWithDegree;
+  using detail::transposeCsrW;
+  using detail::transposeCsr;
+  using detail::transposeWithDegreeCsrW;
+  using detail::transposeWithDegreeCsr;
+  using detail::transposeBatchW;
+  using detail::transposeBatchUpdateU;
+  using detail::transposeWithDegreeBatchUpdateU;
+  using detail::transposeCsrBatchUpdateU;
+  using detail::transposeWithDegreeCsrBatchUpdateU;
   using detail::transposeArenaOmpW;
 #ifdef _OPENMP
   using detail::transposeOmpW;
   using detail::transposeOmp;
   using detail::transposeWithDegreeOmpW;
   using detail::transposeWithDegreeOmp;
+  using detail::transposeCsrOmpW;
+  using detail::transposeCsrOmp;
+  using detail::transposeWithDegreeCsrOmpW;
+  using detail::transposeWithDegreeCsrOmp;
+  using detail::transposeBatchOmpW;
+  using detail::transposeBatchUpdateOmpU;
+  using detail::transposeWithDegreeBatchUpdateOmpU;
+  using detail::transposeCsrBatchUpdateOmpU;
+  using detail::transposeWithDegreeCsrBatchUpdateOmpU;
 #endif
 } // namespace gve
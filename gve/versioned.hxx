@@ -0,0 +1,261 @@
+// Copyright (C) 2025 Subhajit Sahu
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// See LICENSE for full terms
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include "_main.hxx"
+#include "Graph.hxx"
+#include "batch.hxx"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+
+
+// An internal namespace helps to hide implementation details.
+// This is particularly useful for pre-C++20 modules.
+namespace gve {
+namespace detail {
+using std::tuple;
+using std::pair;
+using std::shared_ptr;
+using std::weak_ptr;
+using std::vector;
+using std::min;
+using std::get;
+
+
+
+
+#pragma region CLASSES
+/**
+ * Arena DiGraph with snapshot-isolated versions, for reading while updating.
+ * A single writer updates the graph, and publishes a new version. Each
+ * version is a read-only view that shares the edges of untouched vertices
+ * with the previous one (copy-on-write). Readers pin a version, which stays
+ * intact until they release it. Edges replaced by the writer are freed only
+ * once no pinned version can see them (epoch-based reclamation).
+ * @tparam K key type (vertex id)
+ * @tparam V vertex value type (vertex data)
+ * @tparam E edge value type (edge weight)
+ */
+template <class K=uint32_t, class V=None, class E=None>
+class VersionedArenaDiGraph {
+  #pragma region TYPES
+  public:
+  /** Graph type. */
+  using graph_type = ArenaDiGraph<K, V, E>;
+  /** Pinned version of the graph. */
+  using snapshot_type = shared_ptr<const graph_type>;
+  #pragma endregion
+
+
+  #pragma region DATA
+  protected:
+  /** Graph being updated by the writer. */
+  graph_type x;
+  /** Latest published version. */
+  snapshot_type head;
+  /** Number of latest published version. */
+  size_t epoch = 0;
+  /** Published versions {number, version}, which may still be pinned. */
+  vector<pair<size_t, weak_ptr<const graph_type>>> published;
+  /** Retired edges {last version using them, pointer, bytes}. */
+  vector<tuple<size_t, void*, size_t>> retired;
+  /** Buffer for collecting retired edges {pointer, bytes}. */
+  vector<pair<void*, size_t>> buf;
+  #pragma endregion
+
+
+  #pragma region METHODS
+  #pragma region PROPERTIES
+  public:
+  /**
+   * Get the graph being updated by the writer.
+   * @returns writable graph
+   * @note Call `publish()` after updating, to make the changes visible.
+   */
+  inline graph_type& graph() noexcept {
+    return x;
+  }
+
+  /**
+   * Get the number of the latest published version.
+   * @returns version number (0 if none)
+   */
+  inline size_t version() const noexcept {
+    return epoch;
+  }
+
+  /**
+   * Get the number of retired edge blocks, awaiting reclamation.
+   * @returns number of retired blocks
+   */
+  inline size_t retiredCount() const noexcept {
+    return retired.size();
+  }
+  #pragma endregion
+
+
+  #pragma region READ
+  public:
+  /**
+   * Pin the latest published version, for reading.
+   * @returns pinned version (released when the last copy is dropped)
+   * @note This may be called concurrently with the writer.
+   */
+  inline snapshot_type pin() const {
+    return std::atomic_load(&head);
+  }
+  #pragma endregion
+
+
+  #pragma region UPDATE
+  protected:
+  /**
+   * Collect the edges retired by the writer since the last version.
+   */
+  inline void collectRetired() {
+    x.collectRetiredU(buf);
+    for (auto [ptr, n] : buf)
+      retired.push_back({epoch, ptr, n});
+    buf.clear();
+  }
+
+
+  /**
+   * Make a new version visible to readers.
+   * @param a new version
+   */
+  inline void publishVersion(shared_ptr<graph_type> a) {
+    snapshot_type s = a;
+    std::atomic_store(&head, s);
+    published.push_back({++epoch, s});
+    reclaim();
+  }
+
+
+  public:
+  /**
+   * Free the retired edges that no pinned version can see.
+   */
+  inline void reclaim() {
+    // Find the oldest version still pinned.
+    size_t vmin = epoch;
+    auto ie = std::remove_if(published.begin(), published.end(), [](const auto& p) { return p.second.expired(); });
+    published.erase(ie, published.end());
+    for (const auto& [v, s] : published)
+      vmin = min(vmin, v);
+    // Free edges last used by older versions.
+    auto mx = x.allocator();
+    auto it = std::remove_if(retired.begin(), retired.end(), [&](const auto& r) {
+      if (get<0>(r) >= vmin) return false;
+      mx->deallocate(get<1>(r), get<2>(r));
+      return true;
+    });
+    retired.erase(it, retired.end());
+  }
+
+
+  /**
+   * Publish the current state of the graph as a new version.
+   */
+  inline void publish() {
+    collectRetired();
+    auto a = std::make_shared<graph_type>();
+    x.snapshotW(*a);
+    publishVersion(a);
+  }
+
+
+#ifdef _OPENMP
+  /**
+   * Publish the current state of the graph as a new version [parallel].
+   */
+  inline void publishOmp() {
+    collectRetired();
+    auto a = std::make_shared<graph_type>();
+    x.snapshotOmpW(*a);
+    publishVersion(a);
+  }
+#endif
+  #pragma endregion
+  #pragma endregion
+
+
+  #pragma region CONSTRUCTORS
+  public:
+  /**
+   * Create an empty versioned graph.
+   */
+  VersionedArenaDiGraph() {}
+
+
+  /**
+   * Destroy the Versioned Arena DiGraph.
+   * @note Pinned versions remain valid, as they share the memory allocator,
+   * and retired edges are not freed.
+   */
+  ~VersionedArenaDiGraph() {}
+  #pragma endregion
+};
+#pragma endregion
+
+
+
+
+#pragma region METHODS
+#pragma region APPLY
+/**
+ * Apply a batch update to a versioned graph, and publish a new version.
+ * @param a versioned graph (updated)
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @note Only the edges of vertices in the batch are copied.
+ */
+template <class K, class V, class E, class W>
+inline void applyBatchUpdateU(VersionedArenaDiGraph<K, V, E>& a, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions) {
+  applyBatchUpdateU(a.graph(), deletions, insertions);
+  a.publish();
+}
+
+
+#ifdef _OPENMP
+/**
+ * Apply a batch update to a versioned graph, and publish a new version [parallel].
+ * @param a versioned graph (updated)
+ * @param deletions edge deletions in batch update
+ * @param insertions edge insertions in batch update
+ * @note Only the edges of vertices in the batch are copied.
+ */
+template <class K, class V, class E, class W>
+inline void applyBatchUpdateOmpU(VersionedArenaDiGraph<K, V, E>& a, const vector<tuple<K, K, W>>& deletions, const vector<tuple<K, K, W>>& insertions) {
+  applyBatchUpdateOmpU(a.graph(), deletions, insertions);
+  a.publishOmp();
+}
+#endif
+#pragma endregion
+#pragma endregion
+} // namespace detail
+} // namespace gve
+
+
+
+
+// Now, we export the public API.
+EXPORT namespace gve {
+  // Classes
+  using detail::VersionedArenaDiGraph;
+  // Methods
+  using detail::applyBatchUpdateU;
+#ifdef _OPENMP
+  using detail::applyBatchUpdateOmpU;
+#endif
+} // namespace gve